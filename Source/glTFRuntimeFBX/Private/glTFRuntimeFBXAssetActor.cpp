@@ -3,7 +3,11 @@
 
 #include "glTFRuntimeFBXAssetActor.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "glTFRuntimeFBXGeometryCacheComponent.h"
 #include "Animation/AnimSequence.h"
+#include "PhysicsEngine/BodySetup.h"
 
 // Sets default values
 AglTFRuntimeFBXAssetActor::AglTFRuntimeFBXAssetActor()
@@ -13,6 +17,11 @@ AglTFRuntimeFBXAssetActor::AglTFRuntimeFBXAssetActor()
 	DefaultAnimation = EglTFRuntimeFBXAssetActorDefaultAnimation::Default;
 	bDefaultAnimationLoop = true;
 	bLoadLights = true;
+	MeshInstancing = EglTFRuntimeFBXAssetActorMeshInstancing::None;
+	bPlayGeometryCaches = false;
+	bLoadCollisions = true;
+	bShareSkeletons = false;
+	bMergeRigidMeshes = false;
 
 	AssetRoot = CreateDefaultSubobject<USceneComponent>(TEXT("AssetRoot"));
 	RootComponent = AssetRoot;
@@ -31,6 +40,37 @@ void AglTFRuntimeFBXAssetActor::BeginPlay()
 
 	double LoadingStartTime = FPlatformTime::Seconds();
 
+	// collisions must be known before their owners are built
+	if (bLoadCollisions)
+	{
+		for (const FglTFRuntimeFBXNode& FBXNode : UglTFRuntimeFBXFunctionLibrary::GetFBXNodesMeshes(Asset))
+		{
+			FglTFRuntimeFBXNode OwnerFBXNode;
+			if (FBXNode.CollisionShape != EglTFRuntimeFBXCollisionShape::None && UglTFRuntimeFBXFunctionLibrary::GetFBXCollisionOwnerNode(Asset, FBXNode, OwnerFBXNode))
+			{
+				DiscoveredCollisions.FindOrAdd(OwnerFBXNode.Id).Add(FBXNode);
+			}
+		}
+	}
+
+	// rigid meshes must be known before the skeletal meshes are built
+	if (bMergeRigidMeshes)
+	{
+		for (const FglTFRuntimeFBXNode& FBXNode : UglTFRuntimeFBXFunctionLibrary::GetFBXNodesMeshes(Asset))
+		{
+			if (FBXNode.bHasSkin || FBXNode.bIsLODGroup || FBXNode.bHasGeometryCache || FBXNode.CollisionShape != EglTFRuntimeFBXCollisionShape::None || DiscoveredCollisions.Contains(FBXNode.Id))
+			{
+				continue;
+			}
+
+			FglTFRuntimeFBXNode ParentFBXNode;
+			if (UglTFRuntimeFBXFunctionLibrary::GetFBXNodeParent(Asset, FBXNode, ParentFBXNode) && UglTFRuntimeFBXFunctionLibrary::IsFBXNodeBone(Asset, ParentFBXNode))
+			{
+				RigidMeshes.Add(FBXNode.Id, FBXNode);
+			}
+		}
+	}
+
 	FglTFRuntimeFBXNode RootFBXNode = UglTFRuntimeFBXFunctionLibrary::GetFBXRootNode(Asset);
 
 	for (const FglTFRuntimeFBXNode& ChildNode : UglTFRuntimeFBXFunctionLibrary::GetFBXNodeChildren(Asset, RootFBXNode))
@@ -38,6 +78,36 @@ void AglTFRuntimeFBXAssetActor::BeginPlay()
 		ProcessNode(RootComponent, ChildNode, NAME_None);
 	}
 
+	// rigid meshes not folded by any skeletal mesh are built as usual
+	for (const TPair<USceneComponent*, FglTFRuntimeFBXNode>& Pair : DiscoveredRigidMeshes)
+	{
+		if (MergedRigidMeshes.Contains(Pair.Value.Id))
+		{
+			continue;
+		}
+
+		FglTFRuntimeMeshLOD LOD;
+		bool bIsSkeletal = false;
+		if (UglTFRuntimeFBXFunctionLibrary::LoadFBXAsRuntimeLODByNode(Asset, Pair.Value, LOD, bIsSkeletal, StaticMeshConfig.MaterialsConfig, SkeletalMeshConfig.MaterialsConfig, MeshConfig))
+		{
+			UStaticMeshComponent* NewStaticMeshComponent = NewObject<UStaticMeshComponent>(this, GetSafeNodeName<UStaticMeshComponent>(Pair.Value));
+			if (StaticMeshConfig.Outer == nullptr)
+			{
+				StaticMeshConfig.Outer = NewStaticMeshComponent;
+			}
+			UStaticMesh* StaticMesh = Asset->LoadStaticMeshFromRuntimeLODs(BuildLODChain(LOD), GetLODChainMeshConfig(StaticMeshConfig));
+			if (StaticMesh)
+			{
+				NewStaticMeshComponent->SetStaticMesh(StaticMesh);
+			}
+			NewStaticMeshComponent->SetupAttachment(Pair.Key);
+			NewStaticMeshComponent->RegisterComponent();
+			NewStaticMeshComponent->ComponentTags.Add(*FString::Printf(TEXT("glTFRuntimeFBX::NodeName::%s"), *Pair.Value.Name));
+			AddInstanceComponent(NewStaticMeshComponent);
+			ReceiveOnStaticMeshComponentCreated(NewStaticMeshComponent);
+		}
+	}
+
 	// attach to skeletons
 	for (const TPair<USceneComponent*, FName>& Pair : DiscoveredAttachments)
 	{
@@ -51,6 +121,19 @@ void AglTFRuntimeFBXAssetActor::BeginPlay()
 		}
 	}
 
+	// without a matching skeletal mesh, rigid skins stay on the bone transform
+	for (const TPair<USceneComponent*, FName>& Pair : DiscoveredRigidAttachments)
+	{
+		for (const TPair<USkeletalMeshComponent*, FglTFRuntimeFBXNode>& PairSkeletalMesh : DiscoveredSkeletalMeshes)
+		{
+			if (PairSkeletalMesh.Key->DoesSocketExist(Pair.Value))
+			{
+				Pair.Key->AttachToComponent(PairSkeletalMesh.Key, FAttachmentTransformRules::SnapToTargetIncludingScale, Pair.Value);
+				break;
+			}
+		}
+	}
+
 	if (DefaultAnimation != EglTFRuntimeFBXAssetActorDefaultAnimation::None)
 	{
 		const TArray<FglTFRuntimeFBXAnim> Animations = UglTFRuntimeFBXFunctionLibrary::GetFBXAnimations(Asset);
@@ -133,20 +216,52 @@ void AglTFRuntimeFBXAssetActor::ProcessNode(USceneComponent* CurrentParentCompon
 		return;
 	}
 
+	// collision nodes are never rendered
+	if (bLoadCollisions && FBXNode.CollisionShape != EglTFRuntimeFBXCollisionShape::None)
+	{
+		return;
+	}
+
 	USceneComponent* SceneComponent = nullptr;
-	if (FBXNode.bHasMesh)
+	TArray<USceneComponent*> ClusterComponents;
+	bool bProcessChildren = true;
+	bool bIsRigidSkin = false;
+	bool bIsRigidMesh = false;
+	FglTFRuntimeFBXNode RigidSkinBoneFBXNode;
+
+	// geometry caches without a stream (missing or unmatched cache file, asset without a base directory) are built as regular meshes
+	UglTFRuntimeFBXGeometryCacheComponent* NewGeometryCacheComponent = nullptr;
+	if (!FBXNode.bIsLODGroup && FBXNode.bHasMesh && FBXNode.bHasGeometryCache && bPlayGeometryCaches)
 	{
-		FglTFRuntimeMeshLOD LOD;
+		NewGeometryCacheComponent = NewObject<UglTFRuntimeFBXGeometryCacheComponent>(this, GetSafeNodeName<UglTFRuntimeFBXGeometryCacheComponent>(FBXNode));
+		if (!NewGeometryCacheComponent->LoadFBXGeometryCache(Asset, FBXNode, StaticMeshConfig.MaterialsConfig))
+		{
+			NewGeometryCacheComponent = nullptr;
+		}
+	}
+
+	if (FBXNode.bIsLODGroup)
+	{
+		// the children are the LOD levels, they are built as a single mesh
+		TArray<FglTFRuntimeMeshLOD> LODs;
+		TArray<float> ScreenSizes;
 		bool bIsSkeletal = false;
-		if (UglTFRuntimeFBXFunctionLibrary::LoadFBXAsRuntimeLODByNode(Asset, FBXNode, LOD, bIsSkeletal, StaticMeshConfig.MaterialsConfig, SkeletalMeshConfig.MaterialsConfig))
+		if (UglTFRuntimeFBXFunctionLibrary::LoadFBXLODGroupAsRuntimeLODs(Asset, FBXNode, LODs, ScreenSizes, bIsSkeletal, StaticMeshConfig.MaterialsConfig, SkeletalMeshConfig.MaterialsConfig, MeshConfig))
 		{
+			bProcessChildren = false;
 			if (bIsSkeletal)
 			{
 				USkeletalMeshComponent* NewSkeletalMeshComponent = NewObject<USkeletalMeshComponent>(this, GetSafeNodeName<USkeletalMeshComponent>(FBXNode));
+				MergeRigidMeshes(LODs, FBXNode);
+				FglTFRuntimeSkeletalMeshConfig LODGroupSkeletalMeshConfig = SkeletalMeshConfig;
+				for (int32 LODIndex = 0; LODIndex < LODs.Num(); LODIndex++)
+				{
 #ifdef GLTFRUNTIME_HAS_BONE_REMAPPER_LOD
-				Asset->GetParser()->RemapRuntimeLODBoneNames(LOD, SkeletalMeshConfig.SkeletonConfig);
+					Asset->GetParser()->RemapRuntimeLODBoneNames(LODs[LODIndex], SkeletalMeshConfig.SkeletonConfig);
 #endif
-				USkeletalMesh* SkeletalMesh = Asset->LoadSkeletalMeshFromRuntimeLODs({ LOD }, -1, SkeletalMeshConfig);
+					LODGroupSkeletalMeshConfig.LODScreenSize.Add(LODIndex, ScreenSizes[LODIndex]);
+				}
+				USkeletalMesh* SkeletalMesh = LoadSkeletalMesh(LODs, LODGroupSkeletalMeshConfig);
 				if (SkeletalMesh)
 				{
 					NewSkeletalMeshComponent->SetSkeletalMesh(SkeletalMesh);
@@ -162,9 +277,15 @@ void AglTFRuntimeFBXAssetActor::ProcessNode(USceneComponent* CurrentParentCompon
 				{
 					StaticMeshConfig.Outer = NewStaticMeshComponent;
 				}
-				UStaticMesh* StaticMesh = Asset->LoadStaticMeshFromRuntimeLODs({ LOD }, StaticMeshConfig);
+				FglTFRuntimeStaticMeshConfig LODGroupStaticMeshConfig = StaticMeshConfig;
+				for (int32 LODIndex = 0; LODIndex < LODs.Num(); LODIndex++)
+				{
+					LODGroupStaticMeshConfig.LODScreenSize.Add(LODIndex, ScreenSizes[LODIndex]);
+				}
+				UStaticMesh* StaticMesh = Asset->LoadStaticMeshFromRuntimeLODs(LODs, LODGroupStaticMeshConfig);
 				if (StaticMesh)
 				{
+					LoadCollisions(StaticMesh, FBXNode);
 					NewStaticMeshComponent->SetStaticMesh(StaticMesh);
 				}
 				ReceiveOnStaticMeshComponentCreated(NewStaticMeshComponent);
@@ -172,6 +293,137 @@ void AglTFRuntimeFBXAssetActor::ProcessNode(USceneComponent* CurrentParentCompon
 			}
 		}
 	}
+	else if (RigidMeshes.Contains(FBXNode.Id))
+	{
+		// built (or folded into a skeletal mesh) when the whole hierarchy is known
+		bIsRigidMesh = true;
+	}
+	else if (NewGeometryCacheComponent)
+	{
+		SceneComponent = NewGeometryCacheComponent;
+	}
+	else if (FBXNode.bHasMesh)
+	{
+		// collisions are in the node space, so their owners are never demoted to the bone space
+		FglTFRuntimeFBXMeshConfig NodeMeshConfig = MeshConfig;
+		if (DiscoveredCollisions.Contains(FBXNode.Id))
+		{
+			NodeMeshConfig.bDemoteRigidSkins = false;
+		}
+
+		bIsRigidSkin = NodeMeshConfig.bDemoteRigidSkins && UglTFRuntimeFBXFunctionLibrary::GetFBXRigidSkinBone(Asset, FBXNode, RigidSkinBoneFBXNode);
+
+		// static meshes are built once per ufbx_mesh and materials (geometry transforms and collisions are per node, so those nodes cannot share)
+		const FglTFRuntimeFBXSharedMeshKey SharedMeshKey(FBXNode);
+		const bool bCanShareStaticMesh = FBXNode.MeshId != 0 && !FBXNode.bHasGeometryTransform && !DiscoveredCollisions.Contains(FBXNode.Id);
+		// instances live in actor space, so they cannot follow a bone
+		const bool bCanInstance = bCanShareStaticMesh && SocketName == NAME_None && !bIsRigidSkin && MeshInstancing != EglTFRuntimeFBXAssetActorMeshInstancing::None && !HasBoneAncestor(FBXNode);
+
+		if (bCanInstance && SharedInstancedStaticMeshComponents.Contains(SharedMeshKey))
+		{
+			SharedInstancedStaticMeshComponents[SharedMeshKey]->AddInstance(UglTFRuntimeFBXFunctionLibrary::GetFBXNodeWorldTransform(Asset, FBXNode));
+		}
+		else if (bCanShareStaticMesh && SharedStaticMeshes.Contains(SharedMeshKey))
+		{
+			UStaticMeshComponent* NewStaticMeshComponent = NewObject<UStaticMeshComponent>(this, GetSafeNodeName<UStaticMeshComponent>(FBXNode));
+			NewStaticMeshComponent->SetStaticMesh(SharedStaticMeshes[SharedMeshKey]);
+			ReceiveOnStaticMeshComponentCreated(NewStaticMeshComponent);
+			SceneComponent = NewStaticMeshComponent;
+		}
+		else
+		{
+			TArray<FglTFRuntimeMeshLOD> LODs;
+			bool bIsSkeletal = false;
+			if (UglTFRuntimeFBXFunctionLibrary::LoadFBXAsRuntimeLODClustersByNode(Asset, FBXNode, LODs, bIsSkeletal, StaticMeshConfig.MaterialsConfig, SkeletalMeshConfig.MaterialsConfig, NodeMeshConfig) && LODs.Num() > 0)
+			{
+				FglTFRuntimeMeshLOD& LOD = LODs[0];
+				const bool bIsClustered = LODs.Num() > 1;
+				if (bIsSkeletal)
+				{
+					USkeletalMeshComponent* NewSkeletalMeshComponent = NewObject<USkeletalMeshComponent>(this, GetSafeNodeName<USkeletalMeshComponent>(FBXNode));
+					MergeRigidMeshes(LODs, FBXNode);
+#ifdef GLTFRUNTIME_HAS_BONE_REMAPPER_LOD
+					Asset->GetParser()->RemapRuntimeLODBoneNames(LOD, SkeletalMeshConfig.SkeletonConfig);
+#endif
+					USkeletalMesh* SkeletalMesh = LoadSkeletalMesh(BuildLODChain(LOD), GetLODChainMeshConfig(SkeletalMeshConfig));
+					if (SkeletalMesh)
+					{
+						NewSkeletalMeshComponent->SetSkeletalMesh(SkeletalMesh);
+						DiscoveredSkeletalMeshes.Add(TPair<USkeletalMeshComponent*, FglTFRuntimeFBXNode>(NewSkeletalMeshComponent, FBXNode));
+					}
+					ReceiveOnSkeletalMeshComponentCreated(NewSkeletalMeshComponent);
+					SceneComponent = NewSkeletalMeshComponent;
+				}
+				else if (bCanInstance && !bIsClustered && UglTFRuntimeFBXFunctionLibrary::GetFBXMeshInstances(Asset, FBXNode).FilterByPredicate([&FBXNode](const FglTFRuntimeFBXNode& InstanceFBXNode) { return InstanceFBXNode.MaterialIds == FBXNode.MaterialIds; }).Num() > 1)
+				{
+					UInstancedStaticMeshComponent* NewInstancedStaticMeshComponent = nullptr;
+					if (MeshInstancing == EglTFRuntimeFBXAssetActorMeshInstancing::HierarchicalInstanced)
+					{
+						NewInstancedStaticMeshComponent = NewObject<UHierarchicalInstancedStaticMeshComponent>(this, GetSafeNodeName<UHierarchicalInstancedStaticMeshComponent>(FBXNode));
+					}
+					else
+					{
+						NewInstancedStaticMeshComponent = NewObject<UInstancedStaticMeshComponent>(this, GetSafeNodeName<UInstancedStaticMeshComponent>(FBXNode));
+					}
+					if (StaticMeshConfig.Outer == nullptr)
+					{
+						StaticMeshConfig.Outer = NewInstancedStaticMeshComponent;
+					}
+					UStaticMesh* StaticMesh = Asset->LoadStaticMeshFromRuntimeLODs(BuildLODChain(LOD), GetLODChainMeshConfig(StaticMeshConfig));
+					if (StaticMesh)
+					{
+						NewInstancedStaticMeshComponent->SetStaticMesh(StaticMesh);
+						SharedStaticMeshes.Add(SharedMeshKey, StaticMesh);
+					}
+
+					// instances are expressed in actor space, the node itself becomes a plain scene component
+					NewInstancedStaticMeshComponent->SetupAttachment(GetRootComponent());
+					NewInstancedStaticMeshComponent->RegisterComponent();
+					NewInstancedStaticMeshComponent->ComponentTags.Add(*FString::Printf(TEXT("glTFRuntimeFBX::NodeName::%s"), *FBXNode.Name));
+					AddInstanceComponent(NewInstancedStaticMeshComponent);
+
+					NewInstancedStaticMeshComponent->AddInstance(UglTFRuntimeFBXFunctionLibrary::GetFBXNodeWorldTransform(Asset, FBXNode));
+					SharedInstancedStaticMeshComponents.Add(SharedMeshKey, NewInstancedStaticMeshComponent);
+
+					ReceiveOnStaticMeshComponentCreated(NewInstancedStaticMeshComponent);
+				}
+				else
+				{
+					UStaticMeshComponent* NewStaticMeshComponent = NewObject<UStaticMeshComponent>(this, GetSafeNodeName<UStaticMeshComponent>(FBXNode));
+					if (StaticMeshConfig.Outer == nullptr)
+					{
+						StaticMeshConfig.Outer = NewStaticMeshComponent;
+					}
+					UStaticMesh* StaticMesh = Asset->LoadStaticMeshFromRuntimeLODs(BuildLODChain(LOD), GetLODChainMeshConfig(StaticMeshConfig));
+					if (StaticMesh)
+					{
+						LoadCollisions(StaticMesh, FBXNode);
+						NewStaticMeshComponent->SetStaticMesh(StaticMesh);
+						if (bCanShareStaticMesh && !bIsClustered)
+						{
+							SharedStaticMeshes.Add(SharedMeshKey, StaticMesh);
+						}
+					}
+					ReceiveOnStaticMeshComponentCreated(NewStaticMeshComponent);
+					SceneComponent = NewStaticMeshComponent;
+
+					// additional clusters are children of the first one (they share the node space)
+					for (int32 ClusterIndex = 1; ClusterIndex < LODs.Num(); ClusterIndex++)
+					{
+						UStaticMeshComponent* NewClusterComponent = NewObject<UStaticMeshComponent>(this, GetSafeNodeName<UStaticMeshComponent>(FBXNode));
+						UStaticMesh* ClusterStaticMesh = Asset->LoadStaticMeshFromRuntimeLODs(BuildLODChain(LODs[ClusterIndex]), GetLODChainMeshConfig(StaticMeshConfig));
+						if (ClusterStaticMesh)
+						{
+							NewClusterComponent->SetStaticMesh(ClusterStaticMesh);
+						}
+						NewClusterComponent->SetupAttachment(NewStaticMeshComponent);
+						ReceiveOnStaticMeshComponentCreated(NewClusterComponent);
+						ClusterComponents.Add(NewClusterComponent);
+					}
+				}
+			}
+		}
+	}
 	else if (bLoadLights && FBXNode.bIsLight)
 	{
 		SceneComponent = UglTFRuntimeFBXFunctionLibrary::LoadFBXLight(Asset, FBXNode, this, FglTFRuntimeLightConfig());
@@ -182,11 +434,22 @@ void AglTFRuntimeFBXAssetActor::ProcessNode(USceneComponent* CurrentParentCompon
 		SceneComponent = NewObject<USceneComponent>(this, GetSafeNodeName<USceneComponent>(FBXNode));
 	}
 
+	if (bIsRigidMesh)
+	{
+		DiscoveredRigidMeshes.Add(TPair<USceneComponent*, FglTFRuntimeFBXNode>(SceneComponent, FBXNode));
+	}
+
 	// skeletal meshes have the node transform baked in
 	if (SceneComponent->IsA<USkeletalMeshComponent>())
 	{
 		SceneComponent->SetupAttachment(GetRootComponent());
 	}
+	else if (bIsRigidSkin && SceneComponent->IsA<UStaticMeshComponent>())
+	{
+		SceneComponent->SetupAttachment(GetRootComponent());
+		SceneComponent->SetRelativeTransform(UglTFRuntimeFBXFunctionLibrary::GetFBXNodeWorldTransform(Asset, RigidSkinBoneFBXNode));
+		DiscoveredRigidAttachments.Add(TPair<USceneComponent*, FName>(SceneComponent, *RigidSkinBoneFBXNode.Name));
+	}
 	else
 	{
 		if (SocketName == NAME_None)
@@ -205,12 +468,119 @@ void AglTFRuntimeFBXAssetActor::ProcessNode(USceneComponent* CurrentParentCompon
 
 	AddInstanceComponent(SceneComponent);
 
+	for (USceneComponent* ClusterComponent : ClusterComponents)
+	{
+		ClusterComponent->RegisterComponent();
+		ClusterComponent->ComponentTags.Add(*FString::Printf(TEXT("glTFRuntimeFBX::NodeName::%s"), *FBXNode.Name));
+		AddInstanceComponent(ClusterComponent);
+	}
+
+	if (!bProcessChildren)
+	{
+		return;
+	}
+
 	for (const FglTFRuntimeFBXNode& ChildNode : UglTFRuntimeFBXFunctionLibrary::GetFBXNodeChildren(Asset, FBXNode))
 	{
 		ProcessNode(SceneComponent, ChildNode, NAME_None);
 	}
 }
 
+TArray<FglTFRuntimeMeshLOD> AglTFRuntimeFBXAssetActor::BuildLODChain(const FglTFRuntimeMeshLOD& LOD) const
+{
+	TArray<FglTFRuntimeMeshLOD> LODs = { LOD };
+	UglTFRuntimeFBXFunctionLibrary::GenerateFBXRuntimeLODs(LOD, MeshConfig.LODs, LODs);
+	return LODs;
+}
+
+void AglTFRuntimeFBXAssetActor::LoadCollisions(UStaticMesh* StaticMesh, const FglTFRuntimeFBXNode& FBXNode)
+{
+	if (!DiscoveredCollisions.Contains(FBXNode.Id))
+	{
+		return;
+	}
+
+	UBodySetup* BodySetup = StaticMesh->GetBodySetup();
+	if (!BodySetup)
+	{
+		StaticMesh->CreateBodySetup();
+		BodySetup = StaticMesh->GetBodySetup();
+	}
+
+	// the authored shapes replace any simple collision generated from the render mesh
+	BodySetup->RemoveSimpleCollision();
+	for (const FglTFRuntimeFBXNode& CollisionFBXNode : DiscoveredCollisions[FBXNode.Id])
+	{
+		UglTFRuntimeFBXFunctionLibrary::AddFBXCollisionToBodySetup(Asset, CollisionFBXNode, FBXNode, BodySetup);
+	}
+
+	// physics must not fall back to the per-poly collision
+	if (BodySetup->CollisionTraceFlag == ECollisionTraceFlag::CTF_UseComplexAsSimple)
+	{
+		BodySetup->CollisionTraceFlag = ECollisionTraceFlag::CTF_UseDefault;
+	}
+
+	BodySetup->InvalidatePhysicsData();
+	BodySetup->CreatePhysicsMeshes();
+}
+
+USkeletalMesh* AglTFRuntimeFBXAssetActor::LoadSkeletalMesh(const TArray<FglTFRuntimeMeshLOD>& LODs, const FglTFRuntimeSkeletalMeshConfig& Config)
+{
+	if (!bShareSkeletons || LODs.Num() < 1 || Config.Skeleton)
+	{
+		return Asset->LoadSkeletalMeshFromRuntimeLODs(LODs, -1, Config);
+	}
+
+	FglTFRuntimeSkeletalMeshConfig SharedSkeletonConfig = Config;
+	SharedSkeletonConfig.Skeleton = UglTFRuntimeFBXFunctionLibrary::GetFBXSharedSkeleton(LODs[0]);
+
+	USkeletalMesh* SkeletalMesh = Asset->LoadSkeletalMeshFromRuntimeLODs(LODs, -1, SharedSkeletonConfig);
+	if (SkeletalMesh && !SharedSkeletonConfig.Skeleton)
+	{
+		UglTFRuntimeFBXFunctionLibrary::RegisterFBXSharedSkeleton(LODs[0], SkeletalMesh->GetSkeleton());
+	}
+
+	return SkeletalMesh;
+}
+
+void AglTFRuntimeFBXAssetActor::MergeRigidMeshes(TArray<FglTFRuntimeMeshLOD>& LODs, const FglTFRuntimeFBXNode& SkeletalFBXNode)
+{
+	for (const TPair<uint32, FglTFRuntimeFBXNode>& Pair : RigidMeshes)
+	{
+		if (MergedRigidMeshes.Contains(Pair.Key))
+		{
+			continue;
+		}
+
+		bool bMerged = false;
+		for (FglTFRuntimeMeshLOD& LOD : LODs)
+		{
+			bMerged |= UglTFRuntimeFBXFunctionLibrary::MergeFBXRigidNodeIntoRuntimeLOD(Asset, Pair.Value, SkeletalFBXNode, LOD, SkeletalMeshConfig.MaterialsConfig, MeshConfig);
+		}
+
+		if (bMerged)
+		{
+			MergedRigidMeshes.Add(Pair.Key);
+		}
+	}
+}
+
+bool AglTFRuntimeFBXAssetActor::HasBoneAncestor(const FglTFRuntimeFBXNode& FBXNode) const
+{
+	FglTFRuntimeFBXNode CurrentFBXNode = FBXNode;
+	FglTFRuntimeFBXNode ParentFBXNode;
+	while (UglTFRuntimeFBXFunctionLibrary::GetFBXNodeParent(Asset, CurrentFBXNode, ParentFBXNode))
+	{
+		if (UglTFRuntimeFBXFunctionLibrary::IsFBXNodeBone(Asset, ParentFBXNode))
+		{
+			return true;
+		}
+		CurrentFBXNode = ParentFBXNode;
+	}
+
+	return false;
+}
+
 TArray<FglTFRuntimeFBXAnim> AglTFRuntimeFBXAssetActor::GetFBXAnimations() const
 {
 	if (!Asset)
@@ -228,9 +598,9 @@ void AglTFRuntimeFBXAssetActor::PlayFBXAnimation(const FglTFRuntimeFBXAnim& FBXA
 		for (const TPair<USkeletalMeshComponent*, FglTFRuntimeFBXNode>& Pair : DiscoveredSkeletalMeshes)
 		{
 #if ENGINE_MAJOR_VERSION >= 5
-			UAnimSequence* NewAnimSequence = UglTFRuntimeFBXFunctionLibrary::LoadFBXAnimAsSkeletalMeshAnimation(Asset, FBXAnim, Pair.Value, Pair.Key->GetSkeletalMeshAsset(), SkeletalAnimationConfig);
+			UAnimSequence* NewAnimSequence = UglTFRuntimeFBXFunctionLibrary::LoadFBXAnimAsSkeletalMeshAnimation(Asset, FBXAnim, Pair.Value, Pair.Key->GetSkeletalMeshAsset(), SkeletalAnimationConfig, AnimationConfig);
 #else
-			UAnimSequence* NewAnimSequence = UglTFRuntimeFBXFunctionLibrary::LoadFBXAnimAsSkeletalMeshAnimation(Asset, FBXAnim, Pair.Value, Pair.Key->SkeletalMesh, SkeletalAnimationConfig);
+			UAnimSequence* NewAnimSequence = UglTFRuntimeFBXFunctionLibrary::LoadFBXAnimAsSkeletalMeshAnimation(Asset, FBXAnim, Pair.Value, Pair.Key->SkeletalMesh, SkeletalAnimationConfig, AnimationConfig);
 #endif
 			if (NewAnimSequence)
 			{
@@ -252,9 +622,9 @@ UAnimSequence* AglTFRuntimeFBXAssetActor::LoadFBXAnimation(USkeletalMeshComponen
 			if (Pair.Key == SkeletalMeshComponent)
 			{
 #if ENGINE_MAJOR_VERSION >= 5
-				return UglTFRuntimeFBXFunctionLibrary::LoadFBXAnimAsSkeletalMeshAnimation(Asset, FBXAnim, Pair.Value, SkeletalMeshComponent->GetSkeletalMeshAsset(), SkeletalAnimationConfig);
+				return UglTFRuntimeFBXFunctionLibrary::LoadFBXAnimAsSkeletalMeshAnimation(Asset, FBXAnim, Pair.Value, SkeletalMeshComponent->GetSkeletalMeshAsset(), SkeletalAnimationConfig, AnimationConfig);
 #else
-				return UglTFRuntimeFBXFunctionLibrary::LoadFBXAnimAsSkeletalMeshAnimation(Asset, FBXAnim, Pair.Value, SkeletalMeshComponent->SkeletalMesh, SkeletalAnimationConfig);
+				return UglTFRuntimeFBXFunctionLibrary::LoadFBXAnimAsSkeletalMeshAnimation(Asset, FBXAnim, Pair.Value, SkeletalMeshComponent->SkeletalMesh, SkeletalAnimationConfig, AnimationConfig);
 #endif
 			}
 		}
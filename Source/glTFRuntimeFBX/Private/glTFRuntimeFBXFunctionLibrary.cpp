@@ -1,11 +1,16 @@
 // Copyright 2023-2025 - Roberto De Ioris
 
 #include "glTFRuntimeFBXFunctionLibrary.h"
+#include "glTFRuntimeFBXGeometryCacheStream.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "UObject/StrongObjectPtr.h"
 #include "Components/DirectionalLightComponent.h"
 #include "Components/PointLightComponent.h"
 #include "Components/SpotLightComponent.h"
+#include "Algo/Sort.h"
+#include "Async/ParallelFor.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "Animation/AnimSequence.h"
 #if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 2
 #include "MaterialDomain.h"
 #else
@@ -15,6 +20,44 @@ THIRD_PARTY_INCLUDES_START
 #include "ufbx.h"
 THIRD_PARTY_INCLUDES_END
 
+struct FglTFRuntimeFBXSkinDeformerData
+{
+	TArray<FglTFRuntimeBone> Skeleton;
+	TMap<uint32, TArray<TPair<int32, float>>> JointsWeightsMap;
+	int32 JointsWeightsGroups = 1;
+	// structural hash of the skeleton (parent indices and bone names)
+	uint32 SkeletonHash = 0;
+};
+
+enum class EglTFRuntimeFBXAnimSource : uint8
+{
+	Node,
+	External,
+	Raw
+};
+
+struct FglTFRuntimeFBXAnimSequenceKey
+{
+	EglTFRuntimeFBXAnimSource Source = EglTFRuntimeFBXAnimSource::Node;
+	uint32 AnimStackId = 0;
+	// morph target curves are extracted from the node mesh
+	uint32 NodeId = 0;
+	TWeakObjectPtr<USkeleton> Skeleton;
+	// both the skeletal animation and the FBX animation configs exported as text
+	FString Config;
+	uint32 ConfigHash = 0;
+
+	bool operator==(const FglTFRuntimeFBXAnimSequenceKey& Other) const
+	{
+		return Source == Other.Source && AnimStackId == Other.AnimStackId && NodeId == Other.NodeId && Skeleton == Other.Skeleton && ConfigHash == Other.ConfigHash && Config == Other.Config;
+	}
+
+	friend uint32 GetTypeHash(const FglTFRuntimeFBXAnimSequenceKey& Key)
+	{
+		return HashCombine(HashCombine(HashCombine(GetTypeHash(static_cast<uint8>(Key.Source)), Key.AnimStackId), HashCombine(Key.NodeId, GetTypeHash(Key.Skeleton))), Key.ConfigHash);
+	}
+};
+
 struct FglTFRuntimeFBXCacheData : FglTFRuntimePluginCacheData
 {
 	ufbx_scene* Scene = nullptr;
@@ -24,6 +67,11 @@ struct FglTFRuntimeFBXCacheData : FglTFRuntimePluginCacheData
 
 	~FglTFRuntimeFBXCacheData()
 	{
+		for (const TPair<TPair<ufbx_anim_stack*, int32>, ufbx_baked_anim*>& Pair : BakedAnimsCache)
+		{
+			ufbx_free_baked_anim(Pair.Value);
+		}
+
 		if (Scene)
 		{
 			ufbx_free_scene(Scene);
@@ -33,6 +81,19 @@ struct FglTFRuntimeFBXCacheData : FglTFRuntimePluginCacheData
 	TMap<ufbx_material*, TStrongObjectPtr<UMaterialInterface>> MaterialsCache;
 	TMap<ufbx_texture*, TStrongObjectPtr<UTexture2D>> TexturesCache;
 	FCriticalSection TexturesLock;
+
+	// nullptr for skin deformers that cannot be loaded
+	TMap<ufbx_skin_deformer*, TSharedPtr<const FglTFRuntimeFBXSkinDeformerData>> SkinDeformersCache;
+	// merged skin deformers of meshes with more than one of them
+	TMap<ufbx_mesh*, TSharedPtr<const FglTFRuntimeFBXSkinDeformerData>> MeshesSkinDeformersCache;
+	FCriticalSection SkinDeformersLock;
+
+	// baked once per anim stack and sample rate, freed with the scene
+	TMap<TPair<ufbx_anim_stack*, int32>, ufbx_baked_anim*> BakedAnimsCache;
+	FCriticalSection BakedAnimsLock;
+
+	TMap<FglTFRuntimeFBXAnimSequenceKey, TStrongObjectPtr<UAnimSequence>> AnimSequencesCache;
+	FCriticalSection AnimSequencesLock;
 };
 
 namespace glTFRuntimeFBX
@@ -52,60 +113,96 @@ namespace glTFRuntimeFBX
 		return Asset->GetParser()->TransformTransform(Transform);
 	}
 
-	void FillSkeleton(UglTFRuntimeAsset* Asset, ufbx_skin_deformer* Skin, ufbx_node* Node, const int32 ParentIndex, TArray<FglTFRuntimeBone>& Skeleton, TMap<FString, int32>& BonesMap)
+	void FillSkeleton(UglTFRuntimeAsset* Asset, ufbx_skin_deformer* Skin, ufbx_node* RootNode, TArray<FglTFRuntimeBone>& Skeleton, TMap<FString, int32>& BonesMap)
 	{
+		TMap<ufbx_node*, ufbx_skin_cluster*> ClustersMap;
+		ClustersMap.Reserve(static_cast<int32>(Skin->clusters.count));
+		for (ufbx_skin_cluster* Cluster : Skin->clusters)
+		{
+			ClustersMap.Add(Cluster->bone_node, Cluster);
+		}
 
-		FglTFRuntimeBone Bone;
+		// parents are inverted once (bind pose if the parent is a bone, scene pose otherwise)
+		TMap<ufbx_node*, ufbx_matrix> ParentsInverseMatrices;
+		auto GetParentInverseMatrix = [&ClustersMap, &ParentsInverseMatrices](ufbx_node* Parent) -> const ufbx_matrix&
+		{
+			if (const ufbx_matrix* InverseMatrix = ParentsInverseMatrices.Find(Parent))
+			{
+				return *InverseMatrix;
+			}
+
+			ufbx_skin_cluster** ParentCluster = ClustersMap.Find(Parent);
+			return ParentsInverseMatrices.Add(Parent, ufbx_matrix_invert(ParentCluster ? &(*ParentCluster)->bind_to_world : &Parent->node_to_world));
+		};
 
-		bool bHasBone = false;
+		// iterative depth-first traversal (same order of the recursive one)
+		TArray<TPair<ufbx_node*, int32>> NodesStack;
+		NodesStack.Add(TPair<ufbx_node*, int32>(RootNode, INDEX_NONE));
 
-		for (int32 ClusterIndex = 0; ClusterIndex < Skin->clusters.count; ClusterIndex++)
+		while (NodesStack.Num() > 0)
 		{
-			if (Skin->clusters.data[ClusterIndex]->bone_node == Node)
+			const TPair<ufbx_node*, int32> Item = NodesStack.Pop();
+			ufbx_node* Node = Item.Key;
+
+			FglTFRuntimeBone Bone;
+
+			ufbx_skin_cluster** Cluster = ClustersMap.Find(Node);
+			if (Cluster && Node->parent)
+			{
+				const ufbx_matrix BoneMatrix = ufbx_matrix_mul(&GetParentInverseMatrix(Node->parent), &(*Cluster)->bind_to_world);
+				Bone.Transform = glTFRuntimeFBX::GetTransform(Asset, ufbx_matrix_to_transform(&BoneMatrix));
+			}
+			else
 			{
-				ufbx_matrix BoneMatrix = Skin->clusters.data[ClusterIndex]->bind_to_world;
+				Bone.Transform = glTFRuntimeFBX::GetTransform(Asset, Node->local_transform);
+			}
 
-				bool bFound = false;
-				// now find the parent
-				for (int32 ParentClusterIndex = 0; ParentClusterIndex < Skin->clusters.count; ParentClusterIndex++)
-				{
-					if (Skin->clusters.data[ParentClusterIndex]->bone_node == Skin->clusters.data[ClusterIndex]->bone_node->parent)
-					{
-						ufbx_matrix ParentBoneInverseMatrix = ufbx_matrix_invert(&Skin->clusters.data[ParentClusterIndex]->bind_to_world);
-						BoneMatrix = ufbx_matrix_mul(&ParentBoneInverseMatrix, &BoneMatrix);
-						bFound = true;
-						break;
-					}
-				}
+			Bone.BoneName = UTF8_TO_TCHAR(Node->name.data);
+			Bone.ParentIndex = Item.Value;
 
-				if (!bFound)
-				{
-					ufbx_matrix ParentBoneInverseMatrix = ufbx_matrix_invert(&Skin->clusters.data[ClusterIndex]->bone_node->parent->node_to_world);
-					BoneMatrix = ufbx_matrix_mul(&ParentBoneInverseMatrix, &BoneMatrix);
-				}
+			const int32 NewIndex = Skeleton.Add(MoveTemp(Bone));
 
-				Bone.Transform = glTFRuntimeFBX::GetTransform(Asset, ufbx_matrix_to_transform(&BoneMatrix));
-				bHasBone = true;
-				break;
+			BonesMap.Add(Skeleton[NewIndex].BoneName, NewIndex);
+
+			for (int32 ChildIndex = static_cast<int32>(Node->children.count) - 1; ChildIndex >= 0; ChildIndex--)
+			{
+				NodesStack.Add(TPair<ufbx_node*, int32>(Node->children.data[ChildIndex], NewIndex));
 			}
 		}
+	}
 
-		if (!bHasBone)
+	ufbx_lod_group* GetLODGroup(ufbx_node* Node)
+	{
+		for (ufbx_element* Attrib : Node->all_attribs)
 		{
-			Bone.Transform = glTFRuntimeFBX::GetTransform(Asset, Node->local_transform);
+			if (Attrib->type == UFBX_ELEMENT_LOD_GROUP)
+			{
+				return ufbx_as_lod_group(Attrib);
+			}
 		}
+		return nullptr;
+	}
 
-		Bone.BoneName = UTF8_TO_TCHAR(Node->name.data);
-		Bone.ParentIndex = ParentIndex;
-
-		const int32 NewIndex = Skeleton.Add(Bone);
-
-		BonesMap.Add(Skeleton[NewIndex].BoneName, NewIndex);
+	// Unreal naming convention for simple collisions: UCX_RenderMeshName(_NN)
+	EglTFRuntimeFBXCollisionShape GetCollisionShape(const FString& NodeName, FString& OwnerName)
+	{
+		static const TPair<const TCHAR*, EglTFRuntimeFBXCollisionShape> Prefixes[] =
+		{
+			TPair<const TCHAR*, EglTFRuntimeFBXCollisionShape>(TEXT("UCX_"), EglTFRuntimeFBXCollisionShape::Convex),
+			TPair<const TCHAR*, EglTFRuntimeFBXCollisionShape>(TEXT("UBX_"), EglTFRuntimeFBXCollisionShape::Box),
+			TPair<const TCHAR*, EglTFRuntimeFBXCollisionShape>(TEXT("USP_"), EglTFRuntimeFBXCollisionShape::Sphere)
+		};
 
-		for (ufbx_node* Child : Node->children)
+		for (const TPair<const TCHAR*, EglTFRuntimeFBXCollisionShape>& Prefix : Prefixes)
 		{
-			FillSkeleton(Asset, Skin, Child, NewIndex, Skeleton, BonesMap);
+			if (NodeName.StartsWith(Prefix.Key, ESearchCase::CaseSensitive))
+			{
+				OwnerName = NodeName.RightChop(4);
+				return Prefix.Value;
+			}
 		}
+
+		return EglTFRuntimeFBXCollisionShape::None;
 	}
 
 	void FillNode(UglTFRuntimeAsset* Asset, ufbx_node* Node, FglTFRuntimeFBXNode& FBXNode)
@@ -115,6 +212,17 @@ namespace glTFRuntimeFBX
 		FBXNode.Transform = GetTransform(Asset, Node->local_transform);
 		FBXNode.bHasMesh = Node->mesh != nullptr;
 		FBXNode.bIsLight = Node->light != nullptr;
+		FBXNode.bIsLODGroup = GetLODGroup(Node) != nullptr;
+		FBXNode.bHasGeometryCache = Node->mesh && Node->mesh->cache_deformers.count > 0;
+		FBXNode.MeshId = Node->mesh ? Node->mesh->element_id : 0;
+		for (ufbx_material* Material : Node->materials)
+		{
+			FBXNode.MaterialIds.Add(Material ? Material->element_id : 0);
+		}
+		FBXNode.bHasGeometryTransform = Node->has_geometry_transform;
+		FBXNode.bHasSkin = Node->mesh && Node->mesh->skin_deformers.count > 0;
+		FString CollisionOwnerName;
+		FBXNode.CollisionShape = Node->mesh ? GetCollisionShape(FBXNode.Name, CollisionOwnerName) : EglTFRuntimeFBXCollisionShape::None;
 
 	}
 
@@ -193,6 +301,315 @@ namespace glTFRuntimeFBX
 		return RuntimeFBXCacheData;
 	}
 
+	// structural hash, names are hashed as FName (case insensitive, like the FString comparison in BonesAreEqual)
+	uint32 GetBonesHash(const TArray<FglTFRuntimeBone>& Bones)
+	{
+		uint32 BonesHash = GetTypeHash(Bones.Num());
+		for (const FglTFRuntimeBone& Bone : Bones)
+		{
+			BonesHash = HashCombine(BonesHash, GetTypeHash(Bone.ParentIndex));
+			BonesHash = HashCombine(BonesHash, GetTypeHash(FName(*Bone.BoneName)));
+		}
+		return BonesHash;
+	}
+
+	bool BonesAreEqual(const TArray<FglTFRuntimeBone>& BaseBones, const TArray<FglTFRuntimeBone>& CurrentBones, const bool bCompareReferencePose)
+	{
+		if (BaseBones.Num() != CurrentBones.Num())
+		{
+			return false;
+		}
+
+		for (int32 BoneIndex = 0; BoneIndex < BaseBones.Num(); BoneIndex++)
+		{
+			if (BaseBones[BoneIndex].ParentIndex != CurrentBones[BoneIndex].ParentIndex)
+			{
+				return false;
+			}
+
+			if (BaseBones[BoneIndex].BoneName != CurrentBones[BoneIndex].BoneName)
+			{
+				return false;
+			}
+
+			if (bCompareReferencePose && !BaseBones[BoneIndex].Transform.Equals(CurrentBones[BoneIndex].Transform, KINDA_SMALL_NUMBER))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	TSharedPtr<const FglTFRuntimeFBXSkinDeformerData> GetSkinDeformerData(UglTFRuntimeAsset* Asset, TSharedRef<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData, ufbx_skin_deformer* SkinDeformer)
+	{
+		FScopeLock SkinDeformersLock(&RuntimeFBXCacheData->SkinDeformersLock);
+
+		if (RuntimeFBXCacheData->SkinDeformersCache.Contains(SkinDeformer))
+		{
+			return RuntimeFBXCacheData->SkinDeformersCache[SkinDeformer];
+		}
+
+		TSharedPtr<FglTFRuntimeFBXSkinDeformerData> SkinDeformerData = MakeShared<FglTFRuntimeFBXSkinDeformerData>();
+		if (UglTFRuntimeFBXFunctionLibrary::FillFBXSkinDeformer(Asset, SkinDeformer, SkinDeformerData->Skeleton, SkinDeformerData->JointsWeightsMap, SkinDeformerData->JointsWeightsGroups))
+		{
+			SkinDeformerData->SkeletonHash = GetBonesHash(SkinDeformerData->Skeleton);
+		}
+		else
+		{
+			SkinDeformerData = nullptr;
+		}
+
+		RuntimeFBXCacheData->SkinDeformersCache.Add(SkinDeformer, SkinDeformerData);
+
+		return SkinDeformerData;
+	}
+
+	// all of the skin deformers of a mesh merged (by bone name) in a single skeleton and weights table,
+	// deformers disagreeing on the bind pose of a shared bone are not merged (the first one is used)
+	TSharedPtr<const FglTFRuntimeFBXSkinDeformerData> GetMeshSkinDeformerData(UglTFRuntimeAsset* Asset, TSharedRef<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData, ufbx_mesh* Mesh)
+	{
+		if (Mesh->skin_deformers.count < 1)
+		{
+			return nullptr;
+		}
+
+		if (Mesh->skin_deformers.count == 1)
+		{
+			return GetSkinDeformerData(Asset, RuntimeFBXCacheData, Mesh->skin_deformers.data[0]);
+		}
+
+		FScopeLock SkinDeformersLock(&RuntimeFBXCacheData->SkinDeformersLock);
+
+		if (RuntimeFBXCacheData->MeshesSkinDeformersCache.Contains(Mesh))
+		{
+			return RuntimeFBXCacheData->MeshesSkinDeformersCache[Mesh];
+		}
+
+		TSharedPtr<FglTFRuntimeFBXSkinDeformerData> MergedSkinDeformerData = MakeShared<FglTFRuntimeFBXSkinDeformerData>();
+		TMap<FString, int32> BonesMap;
+		TSet<uint32> SharedVertices;
+		bool bBindPosesMismatch = false;
+
+		for (ufbx_skin_deformer* SkinDeformer : Mesh->skin_deformers)
+		{
+			TSharedPtr<const FglTFRuntimeFBXSkinDeformerData> SkinDeformerData = GetSkinDeformerData(Asset, RuntimeFBXCacheData, SkinDeformer);
+			if (!SkinDeformerData)
+			{
+				MergedSkinDeformerData = nullptr;
+				break;
+			}
+
+			TArray<int32> BonesRemap;
+			BonesRemap.AddUninitialized(SkinDeformerData->Skeleton.Num());
+
+			for (int32 BoneIndex = 0; BoneIndex < SkinDeformerData->Skeleton.Num(); BoneIndex++)
+			{
+				const FglTFRuntimeBone& Bone = SkinDeformerData->Skeleton[BoneIndex];
+				if (const int32* MergedBoneIndex = BonesMap.Find(Bone.BoneName))
+				{
+					if (!MergedSkinDeformerData->Skeleton[*MergedBoneIndex].Transform.Equals(Bone.Transform, KINDA_SMALL_NUMBER))
+					{
+						UE_LOG(LogGLTFRuntime, Warning, TEXT("Skin deformers of mesh %s have different bind poses for bone %s, only the first one will be used"), UTF8_TO_TCHAR(Mesh->name.data), *Bone.BoneName);
+						bBindPosesMismatch = true;
+						break;
+					}
+
+					BonesRemap[BoneIndex] = *MergedBoneIndex;
+					continue;
+				}
+
+				FglTFRuntimeBone MergedBone = Bone;
+				if (Bone.ParentIndex > INDEX_NONE)
+				{
+					MergedBone.ParentIndex = BonesRemap[Bone.ParentIndex];
+				}
+				else if (MergedSkinDeformerData->Skeleton.Num() > 0)
+				{
+					// a skeleton requires a single root, roots are in the scene space so they are rebased in the space of bone 0 (a root too)
+					UE_LOG(LogGLTFRuntime, Warning, TEXT("Skin deformer root %s of mesh %s is not part of the first skeleton, attaching it to %s"), *Bone.BoneName, UTF8_TO_TCHAR(Mesh->name.data), *MergedSkinDeformerData->Skeleton[0].BoneName);
+					MergedBone.ParentIndex = 0;
+					MergedBone.Transform = Bone.Transform.GetRelativeTransform(MergedSkinDeformerData->Skeleton[0].Transform);
+				}
+
+				BonesRemap[BoneIndex] = MergedSkinDeformerData->Skeleton.Add(MoveTemp(MergedBone));
+				BonesMap.Add(Bone.BoneName, BonesRemap[BoneIndex]);
+			}
+
+			if (bBindPosesMismatch)
+			{
+				break;
+			}
+
+			for (const TPair<uint32, TArray<TPair<int32, float>>>& Pair : SkinDeformerData->JointsWeightsMap)
+			{
+				TArray<TPair<int32, float>>* MergedJointsWeights = MergedSkinDeformerData->JointsWeightsMap.Find(Pair.Key);
+				if (!MergedJointsWeights)
+				{
+					MergedJointsWeights = &MergedSkinDeformerData->JointsWeightsMap.Add(Pair.Key);
+				}
+				else
+				{
+					SharedVertices.Add(Pair.Key);
+				}
+
+				for (const TPair<int32, float>& JointWeight : Pair.Value)
+				{
+					const int32 MergedBoneIndex = BonesRemap[JointWeight.Key];
+					TPair<int32, float>* MergedJointWeight = MergedJointsWeights->FindByPredicate([MergedBoneIndex](const TPair<int32, float>& Item) { return Item.Key == MergedBoneIndex; });
+					if (MergedJointWeight)
+					{
+						MergedJointWeight->Value += JointWeight.Value;
+					}
+					else
+					{
+						MergedJointsWeights->Add(TPair<int32, float>(MergedBoneIndex, JointWeight.Value));
+					}
+				}
+			}
+		}
+
+		if (bBindPosesMismatch)
+		{
+			TSharedPtr<const FglTFRuntimeFBXSkinDeformerData> FirstSkinDeformerData = GetSkinDeformerData(Asset, RuntimeFBXCacheData, Mesh->skin_deformers.data[0]);
+			RuntimeFBXCacheData->MeshesSkinDeformersCache.Add(Mesh, FirstSkinDeformerData);
+			return FirstSkinDeformerData;
+		}
+
+		if (MergedSkinDeformerData)
+		{
+			// vertices influenced by multiple deformers are normalized
+			for (const uint32 VertexIndex : SharedVertices)
+			{
+				TArray<TPair<int32, float>>& JointsWeights = MergedSkinDeformerData->JointsWeightsMap[VertexIndex];
+				float TotalWeight = 0;
+				for (const TPair<int32, float>& JointWeight : JointsWeights)
+				{
+					TotalWeight += JointWeight.Value;
+				}
+
+				if (TotalWeight > 0)
+				{
+					for (TPair<int32, float>& JointWeight : JointsWeights)
+					{
+						JointWeight.Value /= TotalWeight;
+					}
+				}
+			}
+
+			int32 MaxBoneInfluences = 4;
+			for (const TPair<uint32, TArray<TPair<int32, float>>>& Pair : MergedSkinDeformerData->JointsWeightsMap)
+			{
+				MaxBoneInfluences = FMath::Max(MaxBoneInfluences, Pair.Value.Num());
+			}
+
+			MergedSkinDeformerData->JointsWeightsGroups = FMath::DivideAndRoundUp(MaxBoneInfluences, 4);
+			MergedSkinDeformerData->SkeletonHash = GetBonesHash(MergedSkinDeformerData->Skeleton);
+		}
+
+		RuntimeFBXCacheData->MeshesSkinDeformersCache.Add(Mesh, MergedSkinDeformerData);
+
+		return MergedSkinDeformerData;
+	}
+
+	// returns the cluster of skins with every vertex fully weighted to a single bone (and without morph targets)
+	ufbx_skin_cluster* GetRigidSkinCluster(ufbx_mesh* Mesh)
+	{
+		if (!Mesh || Mesh->skin_deformers.count != 1 || Mesh->blend_deformers.count > 0)
+		{
+			return nullptr;
+		}
+
+		ufbx_skin_cluster* RigidCluster = nullptr;
+		for (ufbx_skin_cluster* Cluster : Mesh->skin_deformers.data[0]->clusters)
+		{
+			bool bHasWeights = false;
+			for (const ufbx_real Weight : Cluster->weights)
+			{
+				if (Weight > 0)
+				{
+					bHasWeights = true;
+					break;
+				}
+			}
+
+			if (!bHasWeights)
+			{
+				continue;
+			}
+
+			if (RigidCluster || Cluster->num_weights != Mesh->num_vertices)
+			{
+				return nullptr;
+			}
+
+			for (const ufbx_real Weight : Cluster->weights)
+			{
+				if (!FMath::IsNearlyEqual(static_cast<float>(Weight), 1.0f, 0.001f))
+				{
+					return nullptr;
+				}
+			}
+
+			RigidCluster = Cluster;
+		}
+
+		return RigidCluster;
+	}
+
+	bool SkeletonsAreEqual(const FglTFRuntimeFBXSkinDeformerData& BaseSkinDeformer, const FglTFRuntimeFBXSkinDeformerData& CurrentSkinDeformer)
+	{
+		if (&BaseSkinDeformer == &CurrentSkinDeformer)
+		{
+			return true;
+		}
+
+		// the full comparison is required only on hash hits
+		if (BaseSkinDeformer.SkeletonHash != CurrentSkinDeformer.SkeletonHash)
+		{
+			return false;
+		}
+
+		return BonesAreEqual(BaseSkinDeformer.Skeleton, CurrentSkinDeformer.Skeleton, false);
+	}
+
+	// the skin data of a mesh compatible with a skeleton: all of its deformers merged if possible, otherwise the first compatible deformer
+	TSharedPtr<const FglTFRuntimeFBXSkinDeformerData> GetCompatibleMeshSkinDeformerData(UglTFRuntimeAsset* Asset, TSharedRef<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData, ufbx_mesh* Mesh, TFunctionRef<bool(const FglTFRuntimeFBXSkinDeformerData&)> IsCompatible)
+	{
+		TSharedPtr<const FglTFRuntimeFBXSkinDeformerData> MeshSkinDeformerData = GetMeshSkinDeformerData(Asset, RuntimeFBXCacheData, Mesh);
+		if (MeshSkinDeformerData && IsCompatible(*MeshSkinDeformerData))
+		{
+			return MeshSkinDeformerData;
+		}
+
+		if (Mesh->skin_deformers.count < 2)
+		{
+			return nullptr;
+		}
+
+		for (ufbx_skin_deformer* SkinDeformer : Mesh->skin_deformers)
+		{
+			TSharedPtr<const FglTFRuntimeFBXSkinDeformerData> SkinDeformerData = GetSkinDeformerData(Asset, RuntimeFBXCacheData, SkinDeformer);
+			if (SkinDeformerData && IsCompatible(*SkinDeformerData))
+			{
+				return SkinDeformerData;
+			}
+		}
+
+		return nullptr;
+	}
+
+	// process-wide registry of the skeletons built from FBX bones, keyed by the structural hash
+	// (the reference pose is checked on hash hits)
+	struct FSharedSkeleton
+	{
+		TArray<FglTFRuntimeBone> Bones;
+		TWeakObjectPtr<USkeleton> Skeleton;
+	};
+
+	FCriticalSection SharedSkeletonsLock;
+	TMultiMap<uint32, FSharedSkeleton> SharedSkeletons;
+
 	bool LoadTexture(UglTFRuntimeAsset* Asset, TSharedRef<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData, ufbx_texture* Texture, UTexture2D*& TextureCache, const bool bSRGB, const FglTFRuntimeMaterialsConfig& MaterialsConfig)
 	{
 		if (!Texture)
@@ -570,48 +987,2299 @@ namespace glTFRuntimeFBX
 
 		return Material;
 	}
-}
-
-TArray<FglTFRuntimeFBXNode> UglTFRuntimeFBXFunctionLibrary::GetFBXNodes(UglTFRuntimeAsset* Asset)
-{
-	TArray<FglTFRuntimeFBXNode> Nodes;
 
-	if (!Asset)
+	bool CanMergePrimitives(const FglTFRuntimePrimitive& Primitive, const FglTFRuntimePrimitive& OtherPrimitive)
 	{
-		return Nodes;
+		return Primitive.Material == OtherPrimitive.Material &&
+			Primitive.MaterialName == OtherPrimitive.MaterialName &&
+			Primitive.UVs.Num() == OtherPrimitive.UVs.Num() &&
+			(Primitive.Normals.Num() > 0) == (OtherPrimitive.Normals.Num() > 0) &&
+			(Primitive.Colors.Num() > 0) == (OtherPrimitive.Colors.Num() > 0);
 	}
 
-	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
+	void AppendPrimitive(FglTFRuntimePrimitive& Primitive, const FglTFRuntimePrimitive& SourcePrimitive)
 	{
-		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
+		const uint32 Base = Primitive.Positions.Num();
 
-		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
-		if (!RuntimeFBXCacheData)
+		Primitive.Positions.Append(SourcePrimitive.Positions);
+		Primitive.Normals.Append(SourcePrimitive.Normals);
+		Primitive.Colors.Append(SourcePrimitive.Colors);
+
+		for (int32 UVIndex = 0; UVIndex < Primitive.UVs.Num() && UVIndex < SourcePrimitive.UVs.Num(); UVIndex++)
 		{
-			return Nodes;
+			Primitive.UVs[UVIndex].Append(SourcePrimitive.UVs[UVIndex]);
+		}
+
+		Primitive.Indices.Reserve(Primitive.Indices.Num() + SourcePrimitive.Indices.Num());
+		for (const uint32 Index : SourcePrimitive.Indices)
+		{
+			Primitive.Indices.Add(Base + Index);
+		}
+	}
+
+	bool CanMergeSkinnedPrimitives(const FglTFRuntimePrimitive& Primitive, const FglTFRuntimePrimitive& OtherPrimitive)
+	{
+		// morph targets would require zeroed deltas for the appended vertices
+		return CanMergePrimitives(Primitive, OtherPrimitive) &&
+			Primitive.Joints.Num() == OtherPrimitive.Joints.Num() &&
+			(Primitive.Tangents.Num() > 0) == (OtherPrimitive.Tangents.Num() > 0) &&
+			Primitive.MorphTargets.Num() == 0 && OtherPrimitive.MorphTargets.Num() == 0;
+	}
+
+	void AppendSkinnedPrimitive(FglTFRuntimePrimitive& Primitive, const FglTFRuntimePrimitive& SourcePrimitive)
+	{
+		AppendPrimitive(Primitive, SourcePrimitive);
+
+		Primitive.Tangents.Append(SourcePrimitive.Tangents);
+
+		for (int32 JWIndex = 0; JWIndex < Primitive.Joints.Num() && JWIndex < SourcePrimitive.Joints.Num(); JWIndex++)
+		{
+			Primitive.Joints[JWIndex].Append(SourcePrimitive.Joints[JWIndex]);
+			Primitive.Weights[JWIndex].Append(SourcePrimitive.Weights[JWIndex]);
+		}
+
+		Primitive.bHighPrecisionWeights |= SourcePrimitive.bHighPrecisionWeights;
+	}
+
+	void CopyPrimitiveLayout(FglTFRuntimePrimitive& Primitive, const FglTFRuntimePrimitive& SourcePrimitive)
+	{
+		Primitive.Material = SourcePrimitive.Material;
+		Primitive.MaterialName = SourcePrimitive.MaterialName;
+		Primitive.bHighPrecisionWeights = SourcePrimitive.bHighPrecisionWeights;
+
+		Primitive.UVs.AddDefaulted(SourcePrimitive.UVs.Num());
+		Primitive.Joints.AddDefaulted(SourcePrimitive.Joints.Num());
+		Primitive.Weights.AddDefaulted(SourcePrimitive.Weights.Num());
+
+		for (const FglTFRuntimeMorphTarget& SourceMorphTarget : SourcePrimitive.MorphTargets)
+		{
+			FglTFRuntimeMorphTarget MorphTarget;
+			MorphTarget.Name = SourceMorphTarget.Name;
+			Primitive.MorphTargets.Add(MoveTemp(MorphTarget));
+		}
+	}
+
+	// copies every attribute of a vertex, the destination primitive must have been initialized with CopyPrimitiveLayout
+	uint32 AddPrimitiveVertex(FglTFRuntimePrimitive& Primitive, const FglTFRuntimePrimitive& SourcePrimitive, const uint32 SourceIndex)
+	{
+		const uint32 NewIndex = Primitive.Positions.Add(SourcePrimitive.Positions[SourceIndex]);
+
+		if (SourcePrimitive.Normals.IsValidIndex(SourceIndex))
+		{
+			Primitive.Normals.Add(SourcePrimitive.Normals[SourceIndex]);
+		}
+
+		if (SourcePrimitive.Tangents.IsValidIndex(SourceIndex))
+		{
+			Primitive.Tangents.Add(SourcePrimitive.Tangents[SourceIndex]);
+		}
+
+		if (SourcePrimitive.Colors.IsValidIndex(SourceIndex))
+		{
+			Primitive.Colors.Add(SourcePrimitive.Colors[SourceIndex]);
+		}
+
+		for (int32 UVIndex = 0; UVIndex < SourcePrimitive.UVs.Num(); UVIndex++)
+		{
+			Primitive.UVs[UVIndex].Add(SourcePrimitive.UVs[UVIndex][SourceIndex]);
+		}
+
+		for (int32 JWIndex = 0; JWIndex < SourcePrimitive.Joints.Num(); JWIndex++)
+		{
+			Primitive.Joints[JWIndex].Add(SourcePrimitive.Joints[JWIndex][SourceIndex]);
+			Primitive.Weights[JWIndex].Add(SourcePrimitive.Weights[JWIndex][SourceIndex]);
+		}
+
+		for (int32 MorphTargetIndex = 0; MorphTargetIndex < SourcePrimitive.MorphTargets.Num(); MorphTargetIndex++)
+		{
+			const FglTFRuntimeMorphTarget& SourceMorphTarget = SourcePrimitive.MorphTargets[MorphTargetIndex];
+			if (SourceMorphTarget.Positions.IsValidIndex(SourceIndex))
+			{
+				Primitive.MorphTargets[MorphTargetIndex].Positions.Add(SourceMorphTarget.Positions[SourceIndex]);
+			}
+			if (SourceMorphTarget.Normals.IsValidIndex(SourceIndex))
+			{
+				Primitive.MorphTargets[MorphTargetIndex].Normals.Add(SourceMorphTarget.Normals[SourceIndex]);
+			}
+		}
+
+		return NewIndex;
+	}
+
+	template<typename T>
+	void GatherArray(TArray<T>& Array, const TArray<uint32>& VerticesRemap)
+	{
+		if (Array.Num() == 0)
+		{
+			return;
+		}
+
+		TArray<T> NewArray;
+		NewArray.Reserve(VerticesRemap.Num());
+		for (const uint32 Index : VerticesRemap)
+		{
+			NewArray.Add(Array[Index]);
+		}
+		Array = MoveTemp(NewArray);
+	}
+
+	// rebuilds every vertex attribute following VerticesRemap (new index -> old index)
+	void GatherPrimitiveVertices(FglTFRuntimePrimitive& Primitive, const TArray<uint32>& VerticesRemap)
+	{
+		GatherArray(Primitive.Positions, VerticesRemap);
+		GatherArray(Primitive.Normals, VerticesRemap);
+		GatherArray(Primitive.Tangents, VerticesRemap);
+		GatherArray(Primitive.Colors, VerticesRemap);
+
+		for (auto& UVs : Primitive.UVs)
+		{
+			GatherArray(UVs, VerticesRemap);
+		}
+
+		for (auto& Joints : Primitive.Joints)
+		{
+			GatherArray(Joints, VerticesRemap);
+		}
+
+		for (auto& Weights : Primitive.Weights)
+		{
+			GatherArray(Weights, VerticesRemap);
+		}
+
+		for (FglTFRuntimeMorphTarget& MorphTarget : Primitive.MorphTargets)
+		{
+			GatherArray(MorphTarget.Positions, VerticesRemap);
+			GatherArray(MorphTarget.Normals, VerticesRemap);
+		}
+	}
+
+	bool PrimitiveVerticesAreEqual(const FglTFRuntimePrimitive& Primitive, const uint32 A, const uint32 B)
+	{
+		if (Primitive.Positions[A] != Primitive.Positions[B])
+		{
+			return false;
+		}
+
+		if (Primitive.Normals.Num() > 0 && Primitive.Normals[A] != Primitive.Normals[B])
+		{
+			return false;
+		}
+
+		if (Primitive.Tangents.Num() > 0 && Primitive.Tangents[A] != Primitive.Tangents[B])
+		{
+			return false;
+		}
+
+		if (Primitive.Colors.Num() > 0 && Primitive.Colors[A] != Primitive.Colors[B])
+		{
+			return false;
+		}
+
+		for (const auto& UVs : Primitive.UVs)
+		{
+			if (UVs[A] != UVs[B])
+			{
+				return false;
+			}
+		}
+
+		for (int32 JWIndex = 0; JWIndex < Primitive.Joints.Num(); JWIndex++)
+		{
+			for (int32 Influence = 0; Influence < 4; Influence++)
+			{
+				if (Primitive.Joints[JWIndex][A][Influence] != Primitive.Joints[JWIndex][B][Influence] ||
+					Primitive.Weights[JWIndex][A][Influence] != Primitive.Weights[JWIndex][B][Influence])
+				{
+					return false;
+				}
+			}
+		}
+
+		for (const FglTFRuntimeMorphTarget& MorphTarget : Primitive.MorphTargets)
+		{
+			if (MorphTarget.Positions.Num() > 0 && MorphTarget.Positions[A] != MorphTarget.Positions[B])
+			{
+				return false;
+			}
+
+			if (MorphTarget.Normals.Num() > 0 && MorphTarget.Normals[A] != MorphTarget.Normals[B])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// the extracted primitives are non-indexed triangle soups, merge the vertices sharing every attribute
+	void WeldPrimitiveVertices(FglTFRuntimePrimitive& Primitive)
+	{
+		TMultiMap<uint32, int32> VerticesHashes;
+		TArray<uint32> UniqueVertices;
+		TArray<int32> VerticesRemap;
+		VerticesRemap.AddUninitialized(Primitive.Positions.Num());
+
+		for (int32 VertexIndex = 0; VertexIndex < Primitive.Positions.Num(); VertexIndex++)
+		{
+			const uint32 Hash = GetTypeHash(Primitive.Positions[VertexIndex]);
+
+			int32 UniqueIndex = INDEX_NONE;
+			for (TMultiMap<uint32, int32>::TConstKeyIterator It = VerticesHashes.CreateConstKeyIterator(Hash); It; ++It)
+			{
+				if (PrimitiveVerticesAreEqual(Primitive, UniqueVertices[It.Value()], VertexIndex))
+				{
+					UniqueIndex = It.Value();
+					break;
+				}
+			}
+
+			if (UniqueIndex == INDEX_NONE)
+			{
+				UniqueIndex = UniqueVertices.Add(VertexIndex);
+				VerticesHashes.Add(Hash, UniqueIndex);
+			}
+
+			VerticesRemap[VertexIndex] = UniqueIndex;
+		}
+
+		for (uint32& Index : Primitive.Indices)
+		{
+			Index = VerticesRemap[Index];
+		}
+
+		GatherPrimitiveVertices(Primitive, UniqueVertices);
+	}
+
+	// average cache miss ratio of a FIFO post-transform cache
+	float ComputeACMR(const TArray<uint32>& Indices, const int32 NumVertices, const int32 CacheSize)
+	{
+		const int32 NumTriangles = Indices.Num() / 3;
+		if (NumTriangles < 1)
+		{
+			return 0;
+		}
+
+		TArray<int32> CacheTimestamps;
+		CacheTimestamps.Init(INDEX_NONE, NumVertices);
+
+		int32 Misses = 0;
+		for (int32 Index = 0; Index < NumTriangles * 3; Index++)
+		{
+			const uint32 VertexIndex = Indices[Index];
+			if (CacheTimestamps[VertexIndex] == INDEX_NONE || Misses - CacheTimestamps[VertexIndex] >= CacheSize)
+			{
+				CacheTimestamps[VertexIndex] = Misses;
+				Misses++;
+			}
+		}
+
+		return static_cast<float>(Misses) / NumTriangles;
+	}
+
+	// Tipsify (Sander, Nehab, Barczak - "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw")
+	TArray<uint32> TipsifyIndices(const TArray<uint32>& Indices, const int32 NumVertices, const int32 CacheSize)
+	{
+		const int32 NumTriangles = Indices.Num() / 3;
+
+		TArray<uint32> OptimizedIndices;
+		OptimizedIndices.Reserve(NumTriangles * 3);
+
+		if (NumTriangles < 1 || NumVertices < 1)
+		{
+			return OptimizedIndices;
+		}
+
+		TArray<int32> LiveTriangles;
+		LiveTriangles.Init(0, NumVertices);
+		for (int32 Index = 0; Index < NumTriangles * 3; Index++)
+		{
+			LiveTriangles[Indices[Index]]++;
+		}
+
+		TArray<int32> AdjacencyOffsets;
+		AdjacencyOffsets.Init(0, NumVertices + 1);
+		for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+		{
+			AdjacencyOffsets[VertexIndex + 1] = AdjacencyOffsets[VertexIndex] + LiveTriangles[VertexIndex];
+		}
+
+		TArray<int32> Adjacency;
+		Adjacency.AddUninitialized(NumTriangles * 3);
+		TArray<int32> AdjacencyFill = AdjacencyOffsets;
+		for (int32 Index = 0; Index < NumTriangles * 3; Index++)
+		{
+			Adjacency[AdjacencyFill[Indices[Index]]++] = Index / 3;
+		}
+
+		TArray<int32> CacheTimestamps;
+		CacheTimestamps.Init(0, NumVertices);
+		TArray<bool> EmittedTriangles;
+		EmittedTriangles.Init(false, NumTriangles);
+		TArray<int32> DeadEndStack;
+		TArray<int32> Candidates;
+
+		int32 FanningVertex = 0;
+		int32 Timestamp = CacheSize + 1;
+		int32 Cursor = 1;
+
+		while (FanningVertex >= 0)
+		{
+			Candidates.Reset();
+
+			for (int32 AdjacencyIndex = AdjacencyOffsets[FanningVertex]; AdjacencyIndex < AdjacencyOffsets[FanningVertex + 1]; AdjacencyIndex++)
+			{
+				const int32 TriangleIndex = Adjacency[AdjacencyIndex];
+				if (EmittedTriangles[TriangleIndex])
+				{
+					continue;
+				}
+
+				for (int32 Corner = 0; Corner < 3; Corner++)
+				{
+					const int32 VertexIndex = Indices[TriangleIndex * 3 + Corner];
+					OptimizedIndices.Add(VertexIndex);
+					DeadEndStack.Add(VertexIndex);
+					Candidates.Add(VertexIndex);
+					LiveTriangles[VertexIndex]--;
+					if (Timestamp - CacheTimestamps[VertexIndex] > CacheSize)
+					{
+						CacheTimestamps[VertexIndex] = Timestamp;
+						Timestamp++;
+					}
+				}
+
+				EmittedTriangles[TriangleIndex] = true;
+			}
+
+			// prefer the candidate that will still be in cache after fanning all of its triangles
+			int32 NextVertex = INDEX_NONE;
+			int32 BestPriority = -1;
+			for (const int32 VertexIndex : Candidates)
+			{
+				if (LiveTriangles[VertexIndex] > 0)
+				{
+					int32 Priority = 0;
+					if (Timestamp - CacheTimestamps[VertexIndex] + 2 * LiveTriangles[VertexIndex] <= CacheSize)
+					{
+						Priority = Timestamp - CacheTimestamps[VertexIndex];
+					}
+
+					if (Priority > BestPriority)
+					{
+						BestPriority = Priority;
+						NextVertex = VertexIndex;
+					}
+				}
+			}
+
+			// dead end, try the recently used vertices first, then scan the input order
+			while (NextVertex == INDEX_NONE && DeadEndStack.Num() > 0)
+			{
+				const int32 VertexIndex = DeadEndStack.Pop();
+				if (LiveTriangles[VertexIndex] > 0)
+				{
+					NextVertex = VertexIndex;
+				}
+			}
+
+			while (NextVertex == INDEX_NONE && Cursor < NumVertices)
+			{
+				if (LiveTriangles[Cursor] > 0)
+				{
+					NextVertex = Cursor;
+				}
+				Cursor++;
+			}
+
+			FanningVertex = NextVertex;
+		}
+
+		return OptimizedIndices;
+	}
+
+	// renumber vertices in order of first use, so the vertex fetch walks the buffers linearly
+	void ReorderPrimitiveVerticesByFetch(FglTFRuntimePrimitive& Primitive)
+	{
+		TArray<int32> VerticesRemap;
+		VerticesRemap.Init(INDEX_NONE, Primitive.Positions.Num());
+
+		TArray<uint32> FetchOrder;
+		FetchOrder.Reserve(Primitive.Positions.Num());
+
+		for (uint32& Index : Primitive.Indices)
+		{
+			if (VerticesRemap[Index] == INDEX_NONE)
+			{
+				VerticesRemap[Index] = FetchOrder.Add(Index);
+			}
+			Index = VerticesRemap[Index];
+		}
+
+		GatherPrimitiveVertices(Primitive, FetchOrder);
+	}
+
+	void OptimizeRuntimeLOD(FglTFRuntimeMeshLOD& RuntimeLOD, const int32 VertexCacheSize, float& ACMRBefore, float& ACMRAfter)
+	{
+		const int32 CacheSize = FMath::Max(VertexCacheSize, 3);
+
+		double MissesBefore = 0;
+		double MissesAfter = 0;
+		int64 NumTriangles = 0;
+
+		for (FglTFRuntimePrimitive& Primitive : RuntimeLOD.Primitives)
+		{
+			const int32 PrimitiveTriangles = Primitive.Indices.Num() / 3;
+			if (PrimitiveTriangles < 1)
+			{
+				continue;
+			}
+
+			// measured on the welded vertices (the unwelded triangle soup is always 3.0), so only the reordering gain is reported
+			WeldPrimitiveVertices(Primitive);
+			MissesBefore += ComputeACMR(Primitive.Indices, Primitive.Positions.Num(), CacheSize) * PrimitiveTriangles;
+
+			Primitive.Indices = TipsifyIndices(Primitive.Indices, Primitive.Positions.Num(), CacheSize);
+			ReorderPrimitiveVerticesByFetch(Primitive);
+
+			MissesAfter += ComputeACMR(Primitive.Indices, Primitive.Positions.Num(), CacheSize) * PrimitiveTriangles;
+			NumTriangles += PrimitiveTriangles;
+		}
+
+		ACMRBefore = NumTriangles > 0 ? MissesBefore / NumTriangles : 0;
+		ACMRAfter = NumTriangles > 0 ? MissesAfter / NumTriangles : 0;
+	}
+
+	// all of the LODs must share the same skeleton, bones are sorted with parents before children
+	int32 PruneUnweightedBones(TArrayView<FglTFRuntimeMeshLOD> RuntimeLODs, const TSet<FString>& BonesToKeep)
+	{
+		if (RuntimeLODs.Num() < 1 || RuntimeLODs[0].Skeleton.Num() < 1)
+		{
+			return 0;
+		}
+
+		const TArray<FglTFRuntimeBone>& Skeleton = RuntimeLODs[0].Skeleton;
+
+		TArray<bool> KeepBones;
+		KeepBones.AddZeroed(Skeleton.Num());
+
+		for (const FglTFRuntimeMeshLOD& RuntimeLOD : RuntimeLODs)
+		{
+			for (const FglTFRuntimePrimitive& Primitive : RuntimeLOD.Primitives)
+			{
+				for (int32 JWIndex = 0; JWIndex < Primitive.Joints.Num(); JWIndex++)
+				{
+					for (int32 VertexIndex = 0; VertexIndex < Primitive.Joints[JWIndex].Num(); VertexIndex++)
+					{
+						for (int32 Influence = 0; Influence < 4; Influence++)
+						{
+							const int32 BoneIndex = Primitive.Joints[JWIndex][VertexIndex][Influence];
+							if (Primitive.Weights[JWIndex][VertexIndex][Influence] > 0 && KeepBones.IsValidIndex(BoneIndex))
+							{
+								KeepBones[BoneIndex] = true;
+							}
+						}
+					}
+				}
+			}
+		}
+
+		// the root is always required
+		KeepBones[0] = true;
+
+		for (int32 BoneIndex = Skeleton.Num() - 1; BoneIndex >= 0; BoneIndex--)
+		{
+			if (!KeepBones[BoneIndex] && BonesToKeep.Contains(Skeleton[BoneIndex].BoneName))
+			{
+				KeepBones[BoneIndex] = true;
+			}
+
+			if (KeepBones[BoneIndex] && Skeleton[BoneIndex].ParentIndex > INDEX_NONE)
+			{
+				KeepBones[Skeleton[BoneIndex].ParentIndex] = true;
+			}
+		}
+
+		TArray<int32> BonesRemap;
+		BonesRemap.Init(0, Skeleton.Num());
+
+		TArray<FglTFRuntimeBone> PrunedSkeleton;
+		for (int32 BoneIndex = 0; BoneIndex < Skeleton.Num(); BoneIndex++)
+		{
+			if (KeepBones[BoneIndex])
+			{
+				FglTFRuntimeBone Bone = Skeleton[BoneIndex];
+				Bone.ParentIndex = Bone.ParentIndex > INDEX_NONE ? BonesRemap[Bone.ParentIndex] : INDEX_NONE;
+				BonesRemap[BoneIndex] = PrunedSkeleton.Add(MoveTemp(Bone));
+			}
+		}
+
+		const int32 NumPrunedBones = Skeleton.Num() - PrunedSkeleton.Num();
+		if (NumPrunedBones == 0)
+		{
+			return 0;
+		}
+
+		for (FglTFRuntimeMeshLOD& RuntimeLOD : RuntimeLODs)
+		{
+			RuntimeLOD.Skeleton = PrunedSkeleton;
+
+			// zero weighted influences can reference pruned bones, they are remapped to the root
+			for (FglTFRuntimePrimitive& Primitive : RuntimeLOD.Primitives)
+			{
+				for (int32 JWIndex = 0; JWIndex < Primitive.Joints.Num(); JWIndex++)
+				{
+					for (int32 VertexIndex = 0; VertexIndex < Primitive.Joints[JWIndex].Num(); VertexIndex++)
+					{
+						for (int32 Influence = 0; Influence < 4; Influence++)
+						{
+							const int32 BoneIndex = Primitive.Joints[JWIndex][VertexIndex][Influence];
+							Primitive.Joints[JWIndex][VertexIndex][Influence] = BonesRemap.IsValidIndex(BoneIndex) ? BonesRemap[BoneIndex] : 0;
+						}
+					}
+				}
+			}
+		}
+
+		return NumPrunedBones;
+	}
+
+	// bones with attached meshes or lights are sockets
+	void GetSocketBones(TSharedRef<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData, const TArray<FglTFRuntimeBone>& Skeleton, TSet<FString>& SocketBones)
+	{
+		for (const FglTFRuntimeBone& Bone : Skeleton)
+		{
+			ufbx_node** BoneNode = RuntimeFBXCacheData->NodesNamesMap.Find(Bone.BoneName);
+			if (!BoneNode)
+			{
+				continue;
+			}
+
+			for (const ufbx_node* Child : (*BoneNode)->children)
+			{
+				if (Child->mesh || Child->light)
+				{
+					SocketBones.Add(Bone.BoneName);
+					break;
+				}
+			}
+		}
+	}
+
+	void TransformPrimitive(FglTFRuntimePrimitive& Primitive, const FTransform& Transform)
+	{
+		for (FVector& Position : Primitive.Positions)
+		{
+			Position = Transform.TransformPosition(Position);
+		}
+
+		for (FVector& Normal : Primitive.Normals)
+		{
+			Normal = Transform.TransformVectorNoScale(Normal);
+		}
+
+		for (FVector4& Tangent : Primitive.Tangents)
+		{
+			const FVector TangentVector = Transform.TransformVectorNoScale(FVector(Tangent.X, Tangent.Y, Tangent.Z));
+			Tangent = FVector4(TangentVector.X, TangentVector.Y, TangentVector.Z, Tangent.W);
+		}
+
+		for (FglTFRuntimeMorphTarget& MorphTarget : Primitive.MorphTargets)
+		{
+			for (FVector& Position : MorphTarget.Positions)
+			{
+				Position = Transform.TransformVector(Position);
+			}
+
+			for (FVector& Normal : MorphTarget.Normals)
+			{
+				Normal = Transform.TransformVectorNoScale(Normal);
+			}
+		}
+	}
+
+	// the full (sheared too) ufbx matrix in the glTFRuntime space, for primitives already converted by the parser
+	FMatrix GetMatrix(UglTFRuntimeAsset* Asset, const ufbx_matrix& FbxMatrix)
+	{
+		const FMatrix Basis(
+			Asset->GetParser()->TransformPosition(FVector(1, 0, 0)),
+			Asset->GetParser()->TransformPosition(FVector(0, 1, 0)),
+			Asset->GetParser()->TransformPosition(FVector(0, 0, 1)),
+			FVector::ZeroVector);
+
+		const FMatrix Matrix(
+			FVector(FbxMatrix.m00, FbxMatrix.m10, FbxMatrix.m20),
+			FVector(FbxMatrix.m01, FbxMatrix.m11, FbxMatrix.m21),
+			FVector(FbxMatrix.m02, FbxMatrix.m12, FbxMatrix.m22),
+			FVector(FbxMatrix.m03, FbxMatrix.m13, FbxMatrix.m23));
+
+		return Basis.Inverse() * Matrix * Basis;
+	}
+
+	void TransformPrimitive(FglTFRuntimePrimitive& Primitive, const FMatrix& Matrix)
+	{
+		// normals stay perpendicular to the sheared surfaces only with the inverse transpose
+		const FMatrix NormalsMatrix = Matrix.Inverse().GetTransposed();
+
+		for (FVector& Position : Primitive.Positions)
+		{
+			Position = FVector(Matrix.TransformPosition(Position));
+		}
+
+		for (FVector& Normal : Primitive.Normals)
+		{
+			Normal = FVector(NormalsMatrix.TransformVector(Normal)).GetSafeNormal();
+		}
+
+		for (FVector4& Tangent : Primitive.Tangents)
+		{
+			const FVector TangentVector = FVector(Matrix.TransformVector(FVector(Tangent.X, Tangent.Y, Tangent.Z))).GetSafeNormal();
+			Tangent = FVector4(TangentVector.X, TangentVector.Y, TangentVector.Z, Tangent.W);
+		}
+
+		for (FglTFRuntimeMorphTarget& MorphTarget : Primitive.MorphTargets)
+		{
+			for (FVector& Position : MorphTarget.Positions)
+			{
+				Position = FVector(Matrix.TransformVector(Position));
+			}
+
+			for (FVector& Normal : MorphTarget.Normals)
+			{
+				Normal = FVector(NormalsMatrix.TransformVector(Normal));
+			}
+		}
+	}
+
+	// the bone node is part of the hierarchy of a skin deformer of the mesh (same root of FillFBXSkinDeformer)
+	bool IsSkeletonBone(ufbx_mesh* Mesh, ufbx_node* BoneNode)
+	{
+		for (ufbx_skin_deformer* SkinDeformer : Mesh->skin_deformers)
+		{
+			if (SkinDeformer->clusters.count < 1 || !SkinDeformer->clusters.data[0]->bone_node)
+			{
+				continue;
+			}
+
+			ufbx_node* RootNode = SkinDeformer->clusters.data[0]->bone_node;
+			while (RootNode->parent && !RootNode->parent->is_root)
+			{
+				RootNode = RootNode->parent;
+			}
+
+			for (ufbx_node* Node = BoneNode; Node && !Node->is_root; Node = Node->parent)
+			{
+				if (Node == RootNode)
+				{
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	ufbx_node* FindFirstMeshNode(ufbx_node* Node)
+	{
+		if (Node->mesh)
+		{
+			return Node;
+		}
+
+		for (ufbx_node* Child : Node->children)
+		{
+			ufbx_node* MeshNode = FindFirstMeshNode(Child);
+			if (MeshNode)
+			{
+				return MeshNode;
+			}
+		}
+
+		return nullptr;
+	}
+
+	// true for the meshes of a LOD group that are not its level 0 (the mesh LoadFBXLODGroupAsRuntimeLODs uses first)
+	bool IsSecondaryLODLevel(ufbx_node* Node)
+	{
+		for (ufbx_node* Ancestor = Node->parent; Ancestor; Ancestor = Ancestor->parent)
+		{
+			if (!GetLODGroup(Ancestor))
+			{
+				continue;
+			}
+
+			for (ufbx_node* Child : Ancestor->children)
+			{
+				ufbx_node* MeshNode = FindFirstMeshNode(Child);
+				if (MeshNode)
+				{
+					if (MeshNode != Node)
+					{
+						return true;
+					}
+					break;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	struct FQuadric
+	{
+		double XX = 0;
+		double XY = 0;
+		double XZ = 0;
+		double XW = 0;
+		double YY = 0;
+		double YZ = 0;
+		double YW = 0;
+		double ZZ = 0;
+		double ZW = 0;
+		double WW = 0;
+
+		void AddPlane(const FVector& Normal, const double Distance, const double Weight)
+		{
+			XX += Weight * Normal.X * Normal.X;
+			XY += Weight * Normal.X * Normal.Y;
+			XZ += Weight * Normal.X * Normal.Z;
+			XW += Weight * Normal.X * Distance;
+			YY += Weight * Normal.Y * Normal.Y;
+			YZ += Weight * Normal.Y * Normal.Z;
+			YW += Weight * Normal.Y * Distance;
+			ZZ += Weight * Normal.Z * Normal.Z;
+			ZW += Weight * Normal.Z * Distance;
+			WW += Weight * Distance * Distance;
+		}
+
+		void Add(const FQuadric& Other)
+		{
+			XX += Other.XX;
+			XY += Other.XY;
+			XZ += Other.XZ;
+			XW += Other.XW;
+			YY += Other.YY;
+			YZ += Other.YZ;
+			YW += Other.YW;
+			ZZ += Other.ZZ;
+			ZW += Other.ZW;
+			WW += Other.WW;
+		}
+
+		double Evaluate(const FVector& Position) const
+		{
+			const double X = Position.X;
+			const double Y = Position.Y;
+			const double Z = Position.Z;
+			return XX * X * X + 2 * XY * X * Y + 2 * XZ * X * Z + 2 * XW * X +
+				YY * Y * Y + 2 * YZ * Y * Z + 2 * YW * Y +
+				ZZ * Z * Z + 2 * ZW * Z +
+				WW;
+		}
+	};
+
+	struct FCollapseCandidate
+	{
+		double Cost;
+		int32 From;
+		int32 To;
+		uint32 FromVersion;
+		uint32 ToVersion;
+
+		bool operator<(const FCollapseCandidate& Other) const
+		{
+			return Cost < Other.Cost;
+		}
+	};
+
+	// collapses between vertices driven by different bones are delayed, so joints keep their shape
+	constexpr double SkinBoundaryPenalty = 1000;
+
+	// half-edge collapse simplifier: vertices only collapse onto existing ones, so skin weights,
+	// morph targets and uvs are never interpolated. Vertices on open edges (mesh borders, uv seams
+	// and hard edges, as the primitive is welded) are locked.
+	void SimplifyPrimitive(FglTFRuntimePrimitive& Primitive, const int32 TargetTriangles)
+	{
+		const int32 NumVertices = Primitive.Positions.Num();
+		const int32 NumTriangles = Primitive.Indices.Num() / 3;
+		if (NumTriangles <= TargetTriangles)
+		{
+			return;
+		}
+
+		TArray<uint32>& Indices = Primitive.Indices;
+		const TArray<FVector>& Positions = Primitive.Positions;
+
+		TArray<TArray<int32>> VertexTriangles;
+		VertexTriangles.SetNum(NumVertices);
+		TMap<uint64, int32> EdgesUsage;
+		for (int32 TriangleIndex = 0; TriangleIndex < NumTriangles; TriangleIndex++)
+		{
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				const uint32 A = Indices[TriangleIndex * 3 + Corner];
+				const uint32 B = Indices[TriangleIndex * 3 + (Corner + 1) % 3];
+				VertexTriangles[A].Add(TriangleIndex);
+				EdgesUsage.FindOrAdd((static_cast<uint64>(FMath::Min(A, B)) << 32) | FMath::Max(A, B))++;
+			}
+		}
+
+		TArray<bool> LockedVertices;
+		LockedVertices.Init(false, NumVertices);
+		for (const TPair<uint64, int32>& Pair : EdgesUsage)
+		{
+			if (Pair.Value == 1)
+			{
+				LockedVertices[static_cast<int32>(Pair.Key >> 32)] = true;
+				LockedVertices[static_cast<int32>(Pair.Key & 0xFFFFFFFF)] = true;
+			}
+		}
+
+		TArray<FQuadric> Quadrics;
+		Quadrics.SetNum(NumVertices);
+		for (int32 TriangleIndex = 0; TriangleIndex < NumTriangles; TriangleIndex++)
+		{
+			const FVector& P0 = Positions[Indices[TriangleIndex * 3]];
+			const FVector Cross = FVector::CrossProduct(Positions[Indices[TriangleIndex * 3 + 1]] - P0, Positions[Indices[TriangleIndex * 3 + 2]] - P0);
+			const double DoubleArea = Cross.Size();
+			if (DoubleArea <= 0)
+			{
+				continue;
+			}
+
+			const FVector Normal = Cross / DoubleArea;
+			FQuadric Quadric;
+			Quadric.AddPlane(Normal, -FVector::DotProduct(Normal, P0), DoubleArea * 0.5);
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				Quadrics[Indices[TriangleIndex * 3 + Corner]].Add(Quadric);
+			}
+		}
+
+		TArray<int32> DominantBones;
+		DominantBones.Init(INDEX_NONE, NumVertices);
+		for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+		{
+			float BestWeight = 0;
+			for (int32 JWIndex = 0; JWIndex < Primitive.Joints.Num(); JWIndex++)
+			{
+				for (int32 Influence = 0; Influence < 4; Influence++)
+				{
+					if (Primitive.Weights[JWIndex][VertexIndex][Influence] > BestWeight)
+					{
+						BestWeight = Primitive.Weights[JWIndex][VertexIndex][Influence];
+						DominantBones[VertexIndex] = Primitive.Joints[JWIndex][VertexIndex][Influence];
+					}
+				}
+			}
+		}
+
+		TArray<bool> RemovedVertices;
+		RemovedVertices.Init(false, NumVertices);
+		TArray<uint32> Versions;
+		Versions.Init(0, NumVertices);
+
+		TArray<FCollapseCandidate> Heap;
+
+		auto PushCandidate = [&](const int32 From, const int32 To)
+			{
+				if (LockedVertices[From])
+				{
+					return;
+				}
+
+				FQuadric Quadric = Quadrics[From];
+				Quadric.Add(Quadrics[To]);
+
+				FCollapseCandidate Candidate;
+				Candidate.Cost = Quadric.Evaluate(Positions[To]);
+				if (DominantBones[From] != DominantBones[To])
+				{
+					Candidate.Cost += FVector::DistSquared(Positions[From], Positions[To]) * SkinBoundaryPenalty;
+				}
+				Candidate.From = From;
+				Candidate.To = To;
+				Candidate.FromVersion = Versions[From];
+				Candidate.ToVersion = Versions[To];
+				Heap.HeapPush(Candidate);
+			};
+
+		for (int32 TriangleIndex = 0; TriangleIndex < NumTriangles; TriangleIndex++)
+		{
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				PushCandidate(Indices[TriangleIndex * 3 + Corner], Indices[TriangleIndex * 3 + (Corner + 1) % 3]);
+				PushCandidate(Indices[TriangleIndex * 3 + (Corner + 1) % 3], Indices[TriangleIndex * 3 + Corner]);
+			}
+		}
+
+		auto TriangleHasVertex = [&Indices](const int32 TriangleIndex, const uint32 VertexIndex)
+			{
+				return Indices[TriangleIndex * 3] == VertexIndex || Indices[TriangleIndex * 3 + 1] == VertexIndex || Indices[TriangleIndex * 3 + 2] == VertexIndex;
+			};
+
+		TArray<bool> RemovedTriangles;
+		RemovedTriangles.Init(false, NumTriangles);
+		int32 LiveTriangles = NumTriangles;
+
+		FCollapseCandidate Candidate;
+		while (LiveTriangles > TargetTriangles && Heap.Num() > 0)
+		{
+			Heap.HeapPop(Candidate);
+
+			const int32 From = Candidate.From;
+			const int32 To = Candidate.To;
+			if (RemovedVertices[From] || RemovedVertices[To])
+			{
+				continue;
+			}
+
+			if (!VertexTriangles[From].ContainsByPredicate([&](const int32 TriangleIndex) { return TriangleHasVertex(TriangleIndex, To); }))
+			{
+				continue;
+			}
+
+			// the quadrics changed since the push, requeue with the updated cost
+			if (Candidate.FromVersion != Versions[From] || Candidate.ToVersion != Versions[To])
+			{
+				PushCandidate(From, To);
+				continue;
+			}
+
+			bool bFlipsTriangle = false;
+			for (const int32 TriangleIndex : VertexTriangles[From])
+			{
+				if (TriangleHasVertex(TriangleIndex, To))
+				{
+					continue;
+				}
+
+				FVector Corners[3];
+				for (int32 Corner = 0; Corner < 3; Corner++)
+				{
+					Corners[Corner] = Positions[Indices[TriangleIndex * 3 + Corner]];
+				}
+				const FVector NormalBefore = FVector::CrossProduct(Corners[1] - Corners[0], Corners[2] - Corners[0]);
+
+				for (int32 Corner = 0; Corner < 3; Corner++)
+				{
+					if (Indices[TriangleIndex * 3 + Corner] == static_cast<uint32>(From))
+					{
+						Corners[Corner] = Positions[To];
+					}
+				}
+				const FVector NormalAfter = FVector::CrossProduct(Corners[1] - Corners[0], Corners[2] - Corners[0]);
+
+				if (FVector::DotProduct(NormalBefore, NormalAfter) <= 0)
+				{
+					bFlipsTriangle = true;
+					break;
+				}
+			}
+
+			if (bFlipsTriangle)
+			{
+				continue;
+			}
+
+			for (const int32 TriangleIndex : VertexTriangles[From])
+			{
+				if (TriangleHasVertex(TriangleIndex, To))
+				{
+					RemovedTriangles[TriangleIndex] = true;
+					LiveTriangles--;
+					for (int32 Corner = 0; Corner < 3; Corner++)
+					{
+						const int32 VertexIndex = Indices[TriangleIndex * 3 + Corner];
+						if (VertexIndex != From)
+						{
+							VertexTriangles[VertexIndex].RemoveSingleSwap(TriangleIndex);
+						}
+					}
+				}
+				else
+				{
+					for (int32 Corner = 0; Corner < 3; Corner++)
+					{
+						if (Indices[TriangleIndex * 3 + Corner] == static_cast<uint32>(From))
+						{
+							Indices[TriangleIndex * 3 + Corner] = To;
+						}
+					}
+					VertexTriangles[To].Add(TriangleIndex);
+				}
+			}
+
+			VertexTriangles[From].Empty();
+			RemovedVertices[From] = true;
+			Quadrics[To].Add(Quadrics[From]);
+			Versions[To]++;
+
+			for (const int32 TriangleIndex : VertexTriangles[To])
+			{
+				for (int32 Corner = 0; Corner < 3; Corner++)
+				{
+					const int32 VertexIndex = Indices[TriangleIndex * 3 + Corner];
+					if (VertexIndex != To)
+					{
+						PushCandidate(To, VertexIndex);
+						PushCandidate(VertexIndex, To);
+					}
+				}
+			}
+		}
+
+		TArray<uint32> SimplifiedIndices;
+		SimplifiedIndices.Reserve(LiveTriangles * 3);
+		for (int32 TriangleIndex = 0; TriangleIndex < NumTriangles; TriangleIndex++)
+		{
+			if (!RemovedTriangles[TriangleIndex])
+			{
+				SimplifiedIndices.Append(&Indices[TriangleIndex * 3], 3);
+			}
+		}
+		Indices = MoveTemp(SimplifiedIndices);
+
+		// drops the collapsed vertices
+		ReorderPrimitiveVerticesByFetch(Primitive);
+	}
+
+	// every LOD is simplified from the previous one, with a target relative to the source triangles
+	void GenerateRuntimeLODChain(const FglTFRuntimeMeshLOD& RuntimeLOD, const TArray<FglTFRuntimeFBXLODConfig>& LODsConfig, TArray<FglTFRuntimeMeshLOD>& RuntimeLODs)
+	{
+		if (LODsConfig.Num() < 1)
+		{
+			return;
+		}
+
+		FglTFRuntimeMeshLOD CurrentLOD = RuntimeLOD;
+
+		TArray<int32> SourceTriangles;
+		for (FglTFRuntimePrimitive& Primitive : CurrentLOD.Primitives)
+		{
+			WeldPrimitiveVertices(Primitive);
+			SourceTriangles.Add(Primitive.Indices.Num() / 3);
+		}
+
+		for (const FglTFRuntimeFBXLODConfig& LODConfig : LODsConfig)
+		{
+			for (int32 PrimitiveIndex = 0; PrimitiveIndex < CurrentLOD.Primitives.Num(); PrimitiveIndex++)
+			{
+				const int32 TargetTriangles = FMath::Max(1, FMath::CeilToInt(SourceTriangles[PrimitiveIndex] * FMath::Clamp(LODConfig.TrianglesRatio, 0.0f, 1.0f)));
+				SimplifyPrimitive(CurrentLOD.Primitives[PrimitiveIndex], TargetTriangles);
+			}
+			RuntimeLODs.Add(CurrentLOD);
+		}
+	}
+
+	struct FClusterTriangle
+	{
+		int32 PrimitiveIndex;
+		int32 FirstIndex;
+		FVector Centroid;
+	};
+
+	// median split on the longest axis of the centroids bounds until every leaf is under MaxTriangles
+	void SplitTrianglesInClusters(TArray<FClusterTriangle>& Triangles, const int32 MaxTriangles, TArray<TPair<int32, int32>>& Clusters)
+	{
+		TArray<TPair<int32, int32>> Ranges;
+		Ranges.Add(TPair<int32, int32>(0, Triangles.Num()));
+
+		while (Ranges.Num() > 0)
+		{
+			const TPair<int32, int32> Range = Ranges.Pop();
+			const int32 NumTriangles = Range.Value - Range.Key;
+
+			if (NumTriangles <= MaxTriangles)
+			{
+				Clusters.Add(Range);
+				continue;
+			}
+
+			FBox CentroidsBox(EForceInit::ForceInit);
+			for (int32 TriangleIndex = Range.Key; TriangleIndex < Range.Value; TriangleIndex++)
+			{
+				CentroidsBox += Triangles[TriangleIndex].Centroid;
+			}
+
+			const FVector Size = CentroidsBox.GetSize();
+			int32 Axis = 0;
+			if (Size.Y > Size[Axis])
+			{
+				Axis = 1;
+			}
+			if (Size.Z > Size[Axis])
+			{
+				Axis = 2;
+			}
+
+			TArrayView<FClusterTriangle> RangeView(Triangles.GetData() + Range.Key, NumTriangles);
+			Algo::Sort(RangeView, [Axis](const FClusterTriangle& A, const FClusterTriangle& B)
+				{
+					return A.Centroid[Axis] < B.Centroid[Axis];
+				});
+
+			const int32 Median = Range.Key + NumTriangles / 2;
+			Ranges.Add(TPair<int32, int32>(Range.Key, Median));
+			Ranges.Add(TPair<int32, int32>(Median, Range.Value));
+		}
+	}
+
+	void BuildClusteredRuntimeLODs(const FglTFRuntimeMeshLOD& RuntimeLOD, const int32 MaxTriangles, TArray<FglTFRuntimeMeshLOD>& RuntimeLODs)
+	{
+		TArray<FClusterTriangle> Triangles;
+		for (int32 PrimitiveIndex = 0; PrimitiveIndex < RuntimeLOD.Primitives.Num(); PrimitiveIndex++)
+		{
+			const FglTFRuntimePrimitive& Primitive = RuntimeLOD.Primitives[PrimitiveIndex];
+			for (int32 Index = 0; Index + 2 < Primitive.Indices.Num(); Index += 3)
+			{
+				FClusterTriangle Triangle;
+				Triangle.PrimitiveIndex = PrimitiveIndex;
+				Triangle.FirstIndex = Index;
+				Triangle.Centroid = (Primitive.Positions[Primitive.Indices[Index]] + Primitive.Positions[Primitive.Indices[Index + 1]] + Primitive.Positions[Primitive.Indices[Index + 2]]) / 3;
+				Triangles.Add(Triangle);
+			}
+		}
+
+		TArray<TPair<int32, int32>> Clusters;
+		SplitTrianglesInClusters(Triangles, FMath::Max(MaxTriangles, 1), Clusters);
+
+		for (const TPair<int32, int32>& Cluster : Clusters)
+		{
+			FglTFRuntimeMeshLOD ClusterLOD;
+			TMap<int32, int32> PrimitivesMap;
+			TArray<TMap<uint32, uint32>> VerticesMaps;
+
+			for (int32 TriangleIndex = Cluster.Key; TriangleIndex < Cluster.Value; TriangleIndex++)
+			{
+				const FClusterTriangle& Triangle = Triangles[TriangleIndex];
+				const FglTFRuntimePrimitive& SourcePrimitive = RuntimeLOD.Primitives[Triangle.PrimitiveIndex];
+
+				if (!PrimitivesMap.Contains(Triangle.PrimitiveIndex))
+				{
+					const int32 NewPrimitiveIndex = ClusterLOD.Primitives.AddDefaulted();
+					CopyPrimitiveLayout(ClusterLOD.Primitives[NewPrimitiveIndex], SourcePrimitive);
+					PrimitivesMap.Add(Triangle.PrimitiveIndex, NewPrimitiveIndex);
+					VerticesMaps.AddDefaulted();
+				}
+
+				const int32 ClusterPrimitiveIndex = PrimitivesMap[Triangle.PrimitiveIndex];
+				FglTFRuntimePrimitive& Primitive = ClusterLOD.Primitives[ClusterPrimitiveIndex];
+				TMap<uint32, uint32>& VerticesMap = VerticesMaps[ClusterPrimitiveIndex];
+
+				for (int32 Corner = 0; Corner < 3; Corner++)
+				{
+					const uint32 SourceIndex = SourcePrimitive.Indices[Triangle.FirstIndex + Corner];
+					if (!VerticesMap.Contains(SourceIndex))
+					{
+						VerticesMap.Add(SourceIndex, AddPrimitiveVertex(Primitive, SourcePrimitive, SourceIndex));
+					}
+					Primitive.Indices.Add(VerticesMap[SourceIndex]);
+				}
+			}
+
+			RuntimeLODs.Add(MoveTemp(ClusterLOD));
+		}
+	}
+
+	struct FGeneratedNormals
+	{
+		ufbx_node Node;
+		ufbx_mesh Mesh;
+		TArray<uint32> NormalIndices;
+		TArray<ufbx_vec3> Normals;
+	};
+
+	// same logic of ufbx generate_missing_normals but on demand, the normals are computed once per
+	// control point (and smoothing group) and exposed by a shallow copy of the node and its mesh
+	ufbx_node* GenerateMissingNormals(ufbx_node* Node, FGeneratedNormals& GeneratedNormals)
+	{
+		ufbx_mesh* Mesh = Node->mesh;
+		if (!Mesh || Mesh->vertex_normal.exists || Mesh->num_indices == 0)
+		{
+			return Node;
+		}
+
+		TArray<ufbx_topo_edge> Topology;
+		Topology.AddUninitialized(static_cast<int32>(Mesh->num_indices));
+		ufbx_compute_topology(Mesh, Topology.GetData(), Topology.Num());
+
+		GeneratedNormals.NormalIndices.AddUninitialized(static_cast<int32>(Mesh->num_indices));
+		const size_t NumNormals = ufbx_generate_normal_mapping(Mesh, Topology.GetData(), Topology.Num(), GeneratedNormals.NormalIndices.GetData(), GeneratedNormals.NormalIndices.Num(), false);
+
+		GeneratedNormals.Normals.AddUninitialized(static_cast<int32>(NumNormals));
+		ufbx_compute_normals(Mesh, &Mesh->vertex_position, GeneratedNormals.NormalIndices.GetData(), GeneratedNormals.NormalIndices.Num(), GeneratedNormals.Normals.GetData(), GeneratedNormals.Normals.Num());
+
+		GeneratedNormals.Mesh = *Mesh;
+		GeneratedNormals.Mesh.vertex_normal.exists = true;
+		GeneratedNormals.Mesh.vertex_normal.values.data = GeneratedNormals.Normals.GetData();
+		GeneratedNormals.Mesh.vertex_normal.values.count = GeneratedNormals.Normals.Num();
+		GeneratedNormals.Mesh.vertex_normal.indices.data = GeneratedNormals.NormalIndices.GetData();
+		GeneratedNormals.Mesh.vertex_normal.indices.count = GeneratedNormals.NormalIndices.Num();
+		GeneratedNormals.Mesh.vertex_normal.value_reals = 3;
+		GeneratedNormals.Mesh.vertex_normal.unique_per_vertex = NumNormals == Mesh->num_vertices;
+		GeneratedNormals.Mesh.vertex_normal.values_w.data = nullptr;
+		GeneratedNormals.Mesh.vertex_normal.values_w.count = 0;
+		GeneratedNormals.Mesh.generated_normals = true;
+
+		GeneratedNormals.Node = *Node;
+		GeneratedNormals.Node.mesh = &GeneratedNormals.Mesh;
+
+		return &GeneratedNormals.Node;
+	}
+
+	// triangles and quads (the vast majority of game meshes) are emitted directly, only real n-gons go through ufbx_triangulate_face
+	FORCEINLINE void TriangulateFace(ufbx_mesh* Mesh, const ufbx_face Face, TArray<uint32>& TriangleIndices, TArray<uint32>& Corners)
+	{
+		const uint32 First = Face.index_begin;
+
+		if (Face.num_indices == 3)
+		{
+			Corners.Add(First);
+			Corners.Add(First + 1);
+			Corners.Add(First + 2);
+		}
+		else if (Face.num_indices == 4)
+		{
+			// split along the shortest diagonal
+			const ufbx_vec3 P0 = ufbx_get_vertex_vec3(&Mesh->vertex_position, First);
+			const ufbx_vec3 P1 = ufbx_get_vertex_vec3(&Mesh->vertex_position, First + 1);
+			const ufbx_vec3 P2 = ufbx_get_vertex_vec3(&Mesh->vertex_position, First + 2);
+			const ufbx_vec3 P3 = ufbx_get_vertex_vec3(&Mesh->vertex_position, First + 3);
+
+			const ufbx_real Diagonal02 = (P2.x - P0.x) * (P2.x - P0.x) + (P2.y - P0.y) * (P2.y - P0.y) + (P2.z - P0.z) * (P2.z - P0.z);
+			const ufbx_real Diagonal13 = (P3.x - P1.x) * (P3.x - P1.x) + (P3.y - P1.y) * (P3.y - P1.y) + (P3.z - P1.z) * (P3.z - P1.z);
+
+			if (Diagonal02 <= Diagonal13)
+			{
+				Corners.Add(First);
+				Corners.Add(First + 1);
+				Corners.Add(First + 2);
+				Corners.Add(First);
+				Corners.Add(First + 2);
+				Corners.Add(First + 3);
+			}
+			else
+			{
+				Corners.Add(First + 1);
+				Corners.Add(First + 2);
+				Corners.Add(First + 3);
+				Corners.Add(First + 1);
+				Corners.Add(First + 3);
+				Corners.Add(First);
+			}
+		}
+		else if (Face.num_indices > 4)
+		{
+			const uint32 NumTriangles = ufbx_triangulate_face(TriangleIndices.GetData(), TriangleIndices.Num(), Mesh, Face);
+			Corners.Append(TriangleIndices.GetData(), NumTriangles * 3);
+		}
+	}
+
+	namespace EVertexAttributes
+	{
+		enum Type : uint32
+		{
+			Skeletal = 1 << 0,
+			Normals = 1 << 1,
+			UVs = 1 << 2,
+			Colors = 1 << 3,
+			GeometryTransform = 1 << 4,
+			MorphTargets = 1 << 5,
+			All = (1 << 6) - 1
+		};
+	}
+
+	struct FVertexExtractionContext
+	{
+		FglTFRuntimeParser* Parser = nullptr;
+		const ufbx_mesh* Mesh = nullptr;
+		FTransform Transform = FTransform::Identity;
+		// indexed by logical vertex, nullptr for vertices without influences
+		TArray<const TArray<TPair<int32, float>>*> VertexJointsWeights;
+		int32 JointsWeightsGroups = 1;
+		// same order of FglTFRuntimePrimitive::MorphTargets
+		TArray<ufbx_blend_shape*> BlendShapes;
+	};
+
+	// every attribute check is resolved at compile time, so the inner loop has no per-vertex branching on the mesh layout
+	template<uint32 AttributesMask>
+	void ExtractVertices(const FVertexExtractionContext& Context, const TArray<uint32>& Corners, FglTFRuntimePrimitive& Primitive)
+	{
+		constexpr bool bSkeletal = (AttributesMask & EVertexAttributes::Skeletal) != 0;
+		constexpr bool bNormals = (AttributesMask & EVertexAttributes::Normals) != 0;
+		constexpr bool bUVs = (AttributesMask & EVertexAttributes::UVs) != 0;
+		constexpr bool bColors = (AttributesMask & EVertexAttributes::Colors) != 0;
+		constexpr bool bGeometryTransform = (AttributesMask & EVertexAttributes::GeometryTransform) != 0;
+		constexpr bool bMorphTargets = (AttributesMask & EVertexAttributes::MorphTargets) != 0;
+
+		const ufbx_mesh* Mesh = Context.Mesh;
+		FglTFRuntimeParser* Parser = Context.Parser;
+
+		const int32 NumCorners = Corners.Num();
+		const int32 Base = Primitive.Positions.Num();
+
+		Primitive.Positions.AddUninitialized(NumCorners);
+		Primitive.Indices.AddUninitialized(NumCorners);
+
+		if (bNormals)
+		{
+			Primitive.Normals.AddUninitialized(NumCorners);
+		}
+
+		if (bUVs)
+		{
+			Primitive.UVs[0].AddUninitialized(NumCorners);
+		}
+
+		if (bColors)
+		{
+			Primitive.Colors.AddUninitialized(NumCorners);
+		}
+
+		if (bSkeletal)
+		{
+			for (int32 JWIndex = 0; JWIndex < Context.JointsWeightsGroups; JWIndex++)
+			{
+				Primitive.Joints[JWIndex].AddZeroed(NumCorners);
+				Primitive.Weights[JWIndex].AddZeroed(NumCorners);
+			}
+		}
+
+		if (bMorphTargets)
+		{
+			for (FglTFRuntimeMorphTarget& MorphTarget : Primitive.MorphTargets)
+			{
+				MorphTarget.Positions.AddUninitialized(NumCorners);
+			}
+		}
+
+		for (int32 CornerIndex = 0; CornerIndex < NumCorners; CornerIndex++)
+		{
+			const uint32 Index = Corners[CornerIndex];
+			const int32 VertexIndex = Base + CornerIndex;
+
+			const ufbx_vec3 Position = ufbx_get_vertex_vec3(&Mesh->vertex_position, Index);
+			if (bSkeletal || bGeometryTransform)
+			{
+				Primitive.Positions[VertexIndex] = Context.Transform.TransformPosition(Parser->TransformPosition(FVector(Position.x, Position.y, Position.z)));
+			}
+			else
+			{
+				Primitive.Positions[VertexIndex] = Parser->TransformPosition(FVector(Position.x, Position.y, Position.z));
+			}
+
+			if (bSkeletal)
+			{
+				if (const TArray<TPair<int32, float>>* JointsWeights = Context.VertexJointsWeights[Mesh->vertex_indices.data[Index]])
+				{
+					int32 BoneIndex = 0;
+					for (const TPair<int32, float>& Pair : *JointsWeights)
+					{
+						Primitive.Joints[BoneIndex / 4][VertexIndex][BoneIndex % 4] = Pair.Key;
+						Primitive.Weights[BoneIndex / 4][VertexIndex][BoneIndex % 4] = Pair.Value;
+						BoneIndex++;
+					}
+				}
+			}
+
+			if (bMorphTargets)
+			{
+				for (int32 MorphTargetIndex = 0; MorphTargetIndex < Primitive.MorphTargets.Num(); MorphTargetIndex++)
+				{
+					const ufbx_vec3 MorphTargetPosition = ufbx_get_blend_shape_vertex_offset(Context.BlendShapes[MorphTargetIndex], Mesh->vertex_indices.data[Index]);
+					Primitive.MorphTargets[MorphTargetIndex].Positions[VertexIndex] = Parser->TransformPosition(FVector(MorphTargetPosition.x, MorphTargetPosition.y, MorphTargetPosition.z));
+				}
+			}
+
+			if (bNormals)
+			{
+				const ufbx_vec3 Normal = ufbx_get_vertex_vec3(&Mesh->vertex_normal, Index);
+				if (bSkeletal)
+				{
+					Primitive.Normals[VertexIndex] = Context.Transform.TransformVector(Parser->TransformVector(FVector(Normal.x, Normal.y, Normal.z)));
+				}
+				else if (bGeometryTransform)
+				{
+					Primitive.Normals[VertexIndex] = Context.Transform.TransformVectorNoScale(Parser->TransformVector(FVector(Normal.x, Normal.y, Normal.z)));
+				}
+				else
+				{
+					Primitive.Normals[VertexIndex] = Parser->TransformVector(FVector(Normal.x, Normal.y, Normal.z));
+				}
+			}
+
+			if (bUVs)
+			{
+				const ufbx_vec2 UV = ufbx_get_vertex_vec2(&Mesh->vertex_uv, Index);
+				Primitive.UVs[0][VertexIndex] = FVector2D(UV.x, 1 - UV.y);
+			}
+
+			if (bColors)
+			{
+				const ufbx_vec4 Color = ufbx_get_vertex_vec4(&Mesh->vertex_color, Index);
+				Primitive.Colors[VertexIndex] = FVector4(Color.x, Color.y, Color.z, Color.w);
+			}
+
+			Primitive.Indices[VertexIndex] = VertexIndex;
+		}
+	}
+
+	typedef void(*FVertexExtractor)(const FVertexExtractionContext&, const TArray<uint32>&, FglTFRuntimePrimitive&);
+
+	template<uint32 AttributesMask>
+	struct TVertexExtractorSelector
+	{
+		static FVertexExtractor Select(const uint32 RequestedAttributesMask)
+		{
+			if (RequestedAttributesMask == AttributesMask)
+			{
+				return &ExtractVertices<AttributesMask>;
+			}
+			return TVertexExtractorSelector<AttributesMask - 1>::Select(RequestedAttributesMask);
+		}
+	};
+
+	template<>
+	struct TVertexExtractorSelector<0>
+	{
+		static FVertexExtractor Select(const uint32 RequestedAttributesMask)
+		{
+			return &ExtractVertices<0>;
+		}
+	};
+
+	ufbx_baked_anim* GetBakedAnim(TSharedRef<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData, ufbx_anim_stack* AnimStack, const int32 FramesPerSecond)
+	{
+		const TPair<ufbx_anim_stack*, int32> BakedAnimKey(AnimStack, FramesPerSecond);
+
+		{
+			FScopeLock Lock(&RuntimeFBXCacheData->BakedAnimsLock);
+
+			if (ufbx_baked_anim** CachedBakedAnim = RuntimeFBXCacheData->BakedAnimsCache.Find(BakedAnimKey))
+			{
+				return *CachedBakedAnim;
+			}
+		}
+
+		ufbx_bake_opts Options = {};
+		// non-linear curves are resampled at the sampling rate (linear and already dense (mocap) keys are kept as they are),
+		// frames are spaced by Duration / NumFrames, so they can still fall between baked keys and are linearly interpolated
+		Options.resample_rate = FramesPerSecond;
+
+		ufbx_error Error;
+		ufbx_baked_anim* BakedAnim = ufbx_bake_anim(RuntimeFBXCacheData->Scene, AnimStack->anim, &Options, &Error);
+		if (!BakedAnim)
+		{
+			UE_LOG(LogGLTFRuntime, Error, TEXT("Unable to bake FBX animation %s: %s"), UTF8_TO_TCHAR(AnimStack->name.data), UTF8_TO_TCHAR(Error.description.data));
+			return nullptr;
+		}
+
+		// stacks can be baked concurrently, the first one stored wins
+		FScopeLock Lock(&RuntimeFBXCacheData->BakedAnimsLock);
+
+		if (ufbx_baked_anim** CachedBakedAnim = RuntimeFBXCacheData->BakedAnimsCache.Find(BakedAnimKey))
+		{
+			ufbx_free_baked_anim(BakedAnim);
+			return *CachedBakedAnim;
+		}
+
+		RuntimeFBXCacheData->BakedAnimsCache.Add(BakedAnimKey, BakedAnim);
+		return BakedAnim;
+	}
+
+	FRawAnimSequenceTrack SampleBakedNode(UglTFRuntimeAsset* Asset, ufbx_baked_anim* BakedAnim, ufbx_node* Node, const double TimeBegin, const double Delta, const int32 NumFrames)
+	{
+		// nodes not animated by the stack keep their static transform
+		const ufbx_baked_node* BakedNode = ufbx_find_baked_node(BakedAnim, Node);
+
+		FRawAnimSequenceTrack Track;
+		Track.PosKeys.Reserve(NumFrames);
+		Track.RotKeys.Reserve(NumFrames);
+		Track.ScaleKeys.Reserve(NumFrames);
+
+		for (int32 FrameIndex = 0; FrameIndex < NumFrames; FrameIndex++)
+		{
+			ufbx_transform FbxTransform = Node->local_transform;
+			if (BakedNode)
+			{
+				const double Time = TimeBegin + FrameIndex * Delta;
+				FbxTransform.translation = ufbx_evaluate_baked_vec3(BakedNode->translation_keys, Time);
+				FbxTransform.rotation = ufbx_evaluate_baked_quat(BakedNode->rotation_keys, Time);
+				FbxTransform.scale = ufbx_evaluate_baked_vec3(BakedNode->scale_keys, Time);
+			}
+
+			FTransform Transform = GetTransform(Asset, FbxTransform);
+#if ENGINE_MAJOR_VERSION >= 5
+			Track.PosKeys.Add(FVector3f(Transform.GetLocation()));
+			Track.RotKeys.Add(FQuat4f(Transform.GetRotation()));
+			Track.ScaleKeys.Add(FVector3f(Transform.GetScale3D()));
+#else
+			Track.PosKeys.Add(Transform.GetLocation());
+			Track.RotKeys.Add(Transform.GetRotation());
+			Track.ScaleKeys.Add(Transform.GetScale3D());
+#endif
+		}
+
+		return Track;
+	}
+
+	// bone tracks are independent, each one is sampled by a worker into its own slot
+	void SampleBakedNodes(UglTFRuntimeAsset* Asset, ufbx_baked_anim* BakedAnim, const TArray<TPair<FString, ufbx_node*>>& BoneNodes, const double TimeBegin, const double Delta, const int32 NumFrames, FglTFRuntimePoseTracksMap& PosesMap)
+	{
+		TArray<FRawAnimSequenceTrack> Tracks;
+		Tracks.SetNum(BoneNodes.Num());
+
+		ParallelFor(BoneNodes.Num(), [&](const int32 BoneIndex)
+			{
+				Tracks[BoneIndex] = SampleBakedNode(Asset, BakedAnim, BoneNodes[BoneIndex].Value, TimeBegin, Delta, NumFrames);
+			});
+
+		PosesMap.Reserve(PosesMap.Num() + BoneNodes.Num());
+		for (int32 BoneIndex = 0; BoneIndex < BoneNodes.Num(); BoneIndex++)
+		{
+			PosesMap.Add(BoneNodes[BoneIndex].Key, MoveTemp(Tracks[BoneIndex]));
+		}
+	}
+
+	void SampleBlendChannels(ufbx_anim* Anim, ufbx_mesh* Mesh, const double TimeBegin, const double Delta, const int32 NumFrames, TMap<FName, TArray<TPair<float, float>>>& MorphTargetCurves)
+	{
+		TArray<ufbx_blend_channel*> Channels;
+		for (ufbx_blend_deformer* BlendDeformer : Mesh->blend_deformers)
+		{
+			for (ufbx_blend_channel* Channel : BlendDeformer->channels)
+			{
+				Channels.Add(Channel);
+			}
+		}
+
+		TArray<TArray<TPair<float, float>>> Curves;
+		Curves.SetNum(Channels.Num());
+
+		ParallelFor(Channels.Num(), [&](const int32 ChannelIndex)
+			{
+				TArray<TPair<float, float>>& MorphTargetValues = Curves[ChannelIndex];
+				MorphTargetValues.Reserve(NumFrames);
+				for (int32 FrameIndex = 0; FrameIndex < NumFrames; FrameIndex++)
+				{
+					const double Time = TimeBegin + FrameIndex * Delta;
+					MorphTargetValues.Add(TPair<float, float>(Time, ufbx_evaluate_blend_weight(Anim, Channels[ChannelIndex], Time)));
+				}
+			});
+
+		for (int32 ChannelIndex = 0; ChannelIndex < Channels.Num(); ChannelIndex++)
+		{
+			MorphTargetCurves.Add(UTF8_TO_TCHAR(Channels[ChannelIndex]->name.data), MoveTemp(Curves[ChannelIndex]));
+		}
+	}
+
+	template<typename T>
+	bool AreKeysConstant(const TArray<T>& Keys, const float Tolerance)
+	{
+		for (const T& Key : Keys)
+		{
+			if ((Key - Keys[0]).Size() > Tolerance)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename T>
+	bool AreRotationKeysConstant(const TArray<T>& Keys, const float Tolerance)
+	{
+		for (const T& Key : Keys)
+		{
+			if (FMath::RadiansToDegrees(Key.AngularDistance(Keys[0])) > Tolerance)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	FglTFRuntimeFBXAnimSequenceKey GetAnimSequenceKey(const EglTFRuntimeFBXAnimSource Source, const uint32 AnimStackId, const uint32 NodeId, USkeleton* Skeleton, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, const FglTFRuntimeFBXAnimationConfig& AnimationConfig)
+	{
+		FglTFRuntimeFBXAnimSequenceKey Key;
+		Key.Source = Source;
+		Key.AnimStackId = AnimStackId;
+		Key.NodeId = NodeId;
+		Key.Skeleton = Skeleton;
+		// the cache mode decides how the cache is accessed, not what is cached (like the materials cache)
+		FglTFRuntimeSkeletalAnimationConfig KeySkeletalAnimationConfig = SkeletalAnimationConfig;
+		KeySkeletalAnimationConfig.CacheMode = EglTFRuntimeCacheMode::ReadWrite;
+		FglTFRuntimeSkeletalAnimationConfig::StaticStruct()->ExportText(Key.Config, &KeySkeletalAnimationConfig, nullptr, nullptr, PPF_None, nullptr);
+		FglTFRuntimeFBXAnimationConfig::StaticStruct()->ExportText(Key.Config, &AnimationConfig, nullptr, nullptr, PPF_None, nullptr);
+		Key.ConfigHash = GetTypeHash(Key.Config);
+		return Key;
+	}
+
+	UAnimSequence* GetCachedAnimSequence(TSharedRef<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData, const FglTFRuntimeFBXAnimSequenceKey& Key, const EglTFRuntimeCacheMode CacheMode)
+	{
+		if (!CanReadFromCache(CacheMode))
+		{
+			return nullptr;
+		}
+
+		FScopeLock Lock(&RuntimeFBXCacheData->AnimSequencesLock);
+		if (const TStrongObjectPtr<UAnimSequence>* CachedAnimSequence = RuntimeFBXCacheData->AnimSequencesCache.Find(Key))
+		{
+			return CachedAnimSequence->Get();
+		}
+
+		return nullptr;
+	}
+
+	void CacheAnimSequence(TSharedRef<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData, const FglTFRuntimeFBXAnimSequenceKey& Key, UAnimSequence* AnimSequence, const EglTFRuntimeCacheMode CacheMode)
+	{
+		if (!AnimSequence || !CanWriteToCache(CacheMode))
+		{
+			return;
+		}
+
+		FScopeLock Lock(&RuntimeFBXCacheData->AnimSequencesLock);
+		RuntimeFBXCacheData->AnimSequencesCache.Add(Key, TStrongObjectPtr<UAnimSequence>(AnimSequence));
+	}
+
+	// raw tracks are uniformly sampled and UE5 requires the same number of keys for the three channels,
+	// so only the bones that never move are collapsed (a single key for every channel)
+	void ReducePoseTracks(FglTFRuntimePoseTracksMap& PosesMap, const FglTFRuntimeFBXAnimationConfig& AnimationConfig)
+	{
+		if (!AnimationConfig.bReduceKeys)
+		{
+			return;
+		}
+
+		for (TPair<FString, FRawAnimSequenceTrack>& Pair : PosesMap)
+		{
+			FRawAnimSequenceTrack& Track = Pair.Value;
+			if (Track.PosKeys.Num() > 1 &&
+				Track.PosKeys.Num() == Track.RotKeys.Num() &&
+				Track.PosKeys.Num() == Track.ScaleKeys.Num() &&
+				AreKeysConstant(Track.PosKeys, AnimationConfig.TranslationTolerance) &&
+				AreRotationKeysConstant(Track.RotKeys, AnimationConfig.RotationTolerance) &&
+				AreKeysConstant(Track.ScaleKeys, AnimationConfig.ScaleTolerance))
+			{
+				Track.PosKeys.SetNum(1);
+				Track.RotKeys.SetNum(1);
+				Track.ScaleKeys.SetNum(1);
+			}
+		}
+	}
+
+	// morph target curves are keyed by time, every key that can be linearly interpolated by its neighbours is removed
+	void ReduceMorphTargetCurves(TMap<FName, TArray<TPair<float, float>>>& MorphTargetCurves, const FglTFRuntimeFBXAnimationConfig& AnimationConfig)
+	{
+		if (!AnimationConfig.bReduceKeys)
+		{
+			return;
+		}
+
+		for (TPair<FName, TArray<TPair<float, float>>>& Pair : MorphTargetCurves)
+		{
+			const TArray<TPair<float, float>>& Keys = Pair.Value;
+			if (Keys.Num() < 3)
+			{
+				continue;
+			}
+
+			TArray<TPair<float, float>> ReducedKeys;
+			ReducedKeys.Add(Keys[0]);
+
+			int32 AnchorIndex = 0;
+			for (int32 KeyIndex = 1; KeyIndex < Keys.Num() - 1; KeyIndex++)
+			{
+				// can the segment from the anchor to the next key replace every key in between?
+				const TPair<float, float>& Anchor = Keys[AnchorIndex];
+				const TPair<float, float>& Next = Keys[KeyIndex + 1];
+				bool bRequired = false;
+				for (int32 SkippedIndex = AnchorIndex + 1; SkippedIndex <= KeyIndex; SkippedIndex++)
+				{
+					const float Alpha = (Keys[SkippedIndex].Key - Anchor.Key) / FMath::Max(Next.Key - Anchor.Key, SMALL_NUMBER);
+					if (FMath::Abs(FMath::Lerp(Anchor.Value, Next.Value, Alpha) - Keys[SkippedIndex].Value) > AnimationConfig.MorphTargetTolerance)
+					{
+						bRequired = true;
+						break;
+					}
+				}
+
+				if (bRequired)
+				{
+					ReducedKeys.Add(Keys[KeyIndex]);
+					AnchorIndex = KeyIndex;
+				}
+			}
+
+			// constant curves are collapsed to their first key
+			if (ReducedKeys.Num() > 1 || FMath::Abs(Keys.Last().Value - Keys[0].Value) > AnimationConfig.MorphTargetTolerance)
+			{
+				ReducedKeys.Add(Keys.Last());
+			}
+
+			Pair.Value = MoveTemp(ReducedKeys);
+		}
+	}
+}
+
+TArray<FglTFRuntimeFBXNode> UglTFRuntimeFBXFunctionLibrary::GetFBXNodes(UglTFRuntimeAsset* Asset)
+{
+	TArray<FglTFRuntimeFBXNode> Nodes;
+
+	if (!Asset)
+	{
+		return Nodes;
+	}
+
+	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
+	{
+		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
+
+		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
+		if (!RuntimeFBXCacheData)
+		{
+			return Nodes;
+		}
+	}
+
+	for (int32 NodeIndex = 0; NodeIndex < RuntimeFBXCacheData->Scene->nodes.count; NodeIndex++)
+	{
+		FglTFRuntimeFBXNode FBXNode;
+		ufbx_node* Node = RuntimeFBXCacheData->Scene->nodes.data[NodeIndex];
+
+		glTFRuntimeFBX::FillNode(Asset, Node, FBXNode);
+
+		Nodes.Add(MoveTemp(FBXNode));
+	}
+
+	return Nodes;
+}
+
+TArray<FglTFRuntimeFBXNode> UglTFRuntimeFBXFunctionLibrary::GetFBXNodesMeshes(UglTFRuntimeAsset* Asset)
+{
+	TArray<FglTFRuntimeFBXNode> Nodes;
+
+	if (!Asset)
+	{
+		return Nodes;
+	}
+
+	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
+	{
+		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
+
+		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
+		if (!RuntimeFBXCacheData)
+		{
+			return Nodes;
+		}
+	}
+
+	for (int32 NodeIndex = 0; NodeIndex < RuntimeFBXCacheData->Scene->nodes.count; NodeIndex++)
+	{
+		FglTFRuntimeFBXNode FBXNode;
+		ufbx_node* Node = RuntimeFBXCacheData->Scene->nodes.data[NodeIndex];
+		if (!Node->mesh)
+		{
+			continue;
+		}
+
+		glTFRuntimeFBX::FillNode(Asset, Node, FBXNode);
+
+		Nodes.Add(MoveTemp(FBXNode));
+	}
+
+	return Nodes;
+}
+
+FglTFRuntimeFBXNode UglTFRuntimeFBXFunctionLibrary::GetFBXRootNode(UglTFRuntimeAsset* Asset)
+{
+	FglTFRuntimeFBXNode FBXNode;
+
+	if (!Asset)
+	{
+		return FBXNode;
+	}
+
+	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
+	{
+		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
+
+		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
+		if (!RuntimeFBXCacheData)
+		{
+			return FBXNode;
+		}
+	}
+
+	glTFRuntimeFBX::FillNode(Asset, RuntimeFBXCacheData->Scene->root_node, FBXNode);
+
+	return FBXNode;
+}
+
+TArray<FglTFRuntimeFBXNode> UglTFRuntimeFBXFunctionLibrary::GetFBXNodeChildren(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode)
+{
+	TArray<FglTFRuntimeFBXNode> Nodes;
+
+	if (!Asset)
+	{
+		return Nodes;
+	}
+
+	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
+	{
+		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
+
+		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
+		if (!RuntimeFBXCacheData)
+		{
+			return Nodes;
+		}
+	}
+
+	if (RuntimeFBXCacheData->NodesMap.Contains(FBXNode.Id))
+	{
+		for (uint32 ChildNodeIndex = 0; ChildNodeIndex < RuntimeFBXCacheData->NodesMap[FBXNode.Id]->children.count; ChildNodeIndex++)
+		{
+			FglTFRuntimeFBXNode ChildFBXNode;
+			ufbx_node* Node = RuntimeFBXCacheData->NodesMap[FBXNode.Id]->children.data[ChildNodeIndex];
+
+			glTFRuntimeFBX::FillNode(Asset, Node, ChildFBXNode);
+
+			Nodes.Add(MoveTemp(ChildFBXNode));
+		}
+	}
+
+	return Nodes;
+}
+
+bool UglTFRuntimeFBXFunctionLibrary::GetFBXNodeParent(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode, FglTFRuntimeFBXNode& FBXParentNode)
+{
+	if (!Asset)
+	{
+		return false;
+	}
+
+	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
+	{
+		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
+
+		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
+		if (!RuntimeFBXCacheData)
+		{
+			return false;
+		}
+	}
+
+	if (RuntimeFBXCacheData->NodesMap.Contains(FBXNode.Id))
+	{
+		ufbx_node* ParentNode = RuntimeFBXCacheData->NodesMap[FBXNode.Id]->parent;
+		if (!ParentNode)
+		{
+			return false;
+		}
+
+		glTFRuntimeFBX::FillNode(Asset, ParentNode, FBXParentNode);
+		return true;
+	}
+
+	return false;
+}
+
+TArray<FglTFRuntimeFBXNode> UglTFRuntimeFBXFunctionLibrary::GetFBXMeshInstances(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode)
+{
+	TArray<FglTFRuntimeFBXNode> Nodes;
+
+	if (!Asset)
+	{
+		return Nodes;
+	}
+
+	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
+	{
+		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
+
+		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
+		if (!RuntimeFBXCacheData)
+		{
+			return Nodes;
+		}
+	}
+
+	if (RuntimeFBXCacheData->NodesMap.Contains(FBXNode.Id))
+	{
+		ufbx_mesh* Mesh = RuntimeFBXCacheData->NodesMap[FBXNode.Id]->mesh;
+		if (!Mesh)
+		{
+			return Nodes;
+		}
+
+		for (uint32 InstanceIndex = 0; InstanceIndex < Mesh->instances.count; InstanceIndex++)
+		{
+			FglTFRuntimeFBXNode InstanceFBXNode;
+			glTFRuntimeFBX::FillNode(Asset, Mesh->instances.data[InstanceIndex], InstanceFBXNode);
+
+			Nodes.Add(MoveTemp(InstanceFBXNode));
+		}
+	}
+
+	return Nodes;
+}
+
+FTransform UglTFRuntimeFBXFunctionLibrary::GetFBXNodeWorldTransform(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode)
+{
+	if (!Asset)
+	{
+		return FTransform::Identity;
+	}
+
+	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
+	{
+		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
+
+		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
+		if (!RuntimeFBXCacheData)
+		{
+			return FTransform::Identity;
+		}
+	}
+
+	if (!RuntimeFBXCacheData->NodesMap.Contains(FBXNode.Id))
+	{
+		return FTransform::Identity;
+	}
+
+	return glTFRuntimeFBX::GetTransform(Asset, ufbx_matrix_to_transform(&RuntimeFBXCacheData->NodesMap[FBXNode.Id]->node_to_world));
+}
+
+bool UglTFRuntimeFBXFunctionLibrary::IsFBXNodeBone(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode)
+{
+	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
+	{
+		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
+
+		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
+		if (!RuntimeFBXCacheData)
+		{
+			return false;
+		}
+	}
+
+	if (RuntimeFBXCacheData->NodesMap.Contains(FBXNode.Id))
+	{
+		ufbx_node* Node = RuntimeFBXCacheData->NodesMap[FBXNode.Id];
+		for (uint32 ClusterIndex = 0; ClusterIndex < RuntimeFBXCacheData->Scene->skin_clusters.count; ClusterIndex++)
+		{
+			ufbx_skin_cluster* Cluster = RuntimeFBXCacheData->Scene->skin_clusters.data[ClusterIndex];
+			if (Cluster->bone_node == Node)
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+bool UglTFRuntimeFBXFunctionLibrary::GetFBXCollisionOwnerNode(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& CollisionFBXNode, FglTFRuntimeFBXNode& OwnerFBXNode)
+{
+	if (!Asset)
+	{
+		return false;
+	}
+
+	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
+	{
+		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
+
+		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
+		if (!RuntimeFBXCacheData)
+		{
+			return false;
+		}
+	}
+
+	if (!RuntimeFBXCacheData->NodesMap.Contains(CollisionFBXNode.Id))
+	{
+		return false;
+	}
+
+	ufbx_node* Node = RuntimeFBXCacheData->NodesMap[CollisionFBXNode.Id];
+
+	FString OwnerName;
+	if (!Node->mesh || glTFRuntimeFBX::GetCollisionShape(CollisionFBXNode.Name, OwnerName) == EglTFRuntimeFBXCollisionShape::None)
+	{
+		return false;
+	}
+
+	// LOD groups are built as a single mesh, so they can own collisions too
+	auto IsRenderMesh = [](ufbx_node* OwnerNode)
+	{
+		return OwnerNode && (OwnerNode->mesh || glTFRuntimeFBX::GetLODGroup(OwnerNode));
+	};
+
+	ufbx_node* OwnerNode = nullptr;
+	if (RuntimeFBXCacheData->NodesNamesMap.Contains(OwnerName))
+	{
+		OwnerNode = RuntimeFBXCacheData->NodesNamesMap[OwnerName];
+	}
+
+	// multiple collisions are numbered (UCX_RenderMeshName_00, UCX_RenderMeshName_01, ...)
+	int32 SuffixIndex = INDEX_NONE;
+	if (!IsRenderMesh(OwnerNode) && OwnerName.FindLastChar(TEXT('_'), SuffixIndex) && SuffixIndex > 0)
+	{
+		const FString Suffix = OwnerName.RightChop(SuffixIndex + 1);
+		const FString BaseName = OwnerName.Left(SuffixIndex);
+		if (Suffix.IsNumeric() && RuntimeFBXCacheData->NodesNamesMap.Contains(BaseName))
+		{
+			OwnerNode = RuntimeFBXCacheData->NodesNamesMap[BaseName];
+		}
+	}
+
+	// fallback to the parent (collisions are often children of their render mesh)
+	if (!IsRenderMesh(OwnerNode))
+	{
+		OwnerNode = Node->parent;
+	}
+
+	if (!IsRenderMesh(OwnerNode) || OwnerNode == Node)
+	{
+		return false;
+	}
+
+	glTFRuntimeFBX::FillNode(Asset, OwnerNode, OwnerFBXNode);
+	return OwnerFBXNode.CollisionShape == EglTFRuntimeFBXCollisionShape::None;
+}
+
+bool UglTFRuntimeFBXFunctionLibrary::AddFBXCollisionToBodySetup(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& CollisionFBXNode, const FglTFRuntimeFBXNode& OwnerFBXNode, UBodySetup* BodySetup)
+{
+	if (!Asset || !BodySetup || CollisionFBXNode.CollisionShape == EglTFRuntimeFBXCollisionShape::None)
+	{
+		return false;
+	}
+
+	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
+	{
+		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
+
+		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
+		if (!RuntimeFBXCacheData)
+		{
+			return false;
+		}
+	}
+
+	if (!RuntimeFBXCacheData->NodesMap.Contains(CollisionFBXNode.Id) || !RuntimeFBXCacheData->NodesMap.Contains(OwnerFBXNode.Id))
+	{
+		return false;
+	}
+
+	ufbx_node* Node = RuntimeFBXCacheData->NodesMap[CollisionFBXNode.Id];
+	ufbx_node* OwnerNode = RuntimeFBXCacheData->NodesMap[OwnerFBXNode.Id];
+
+	// vertices are extracted in the collision node space (materials are not required)
+	FglTFRuntimeMaterialsConfig MaterialsConfig;
+	MaterialsConfig.bSkipLoad = true;
+
+	TArray<FglTFRuntimePrimitive> Primitives;
+	TMap<uint32, TArray<TPair<int32, float>>> EmptyJointsWeightsMap;
+	if (!FillFBXPrimitives(Asset, RuntimeFBXCacheData, Node, 0, Primitives, EmptyJointsWeightsMap, 1, MaterialsConfig))
+	{
+		return false;
+	}
+
+	TArray<FVector> Positions;
+	for (const FglTFRuntimePrimitive& Primitive : Primitives)
+	{
+		Positions.Append(Primitive.Positions);
+	}
+
+	if (Positions.Num() == 0)
+	{
+		return false;
+	}
+
+	const ufbx_matrix OwnerWorldToNode = ufbx_matrix_invert(&OwnerNode->node_to_world);
+	const ufbx_matrix RelativeMatrix = ufbx_matrix_mul(&OwnerWorldToNode, &Node->node_to_world);
+	const FTransform RelativeTransform = glTFRuntimeFBX::GetTransform(Asset, ufbx_matrix_to_transform(&RelativeMatrix));
+
+	const FBox LocalBox(Positions);
+
+	if (CollisionFBXNode.CollisionShape == EglTFRuntimeFBXCollisionShape::Box)
+	{
+		const FVector Size = LocalBox.GetSize() * RelativeTransform.GetScale3D().GetAbs();
+		FKBoxElem BoxElem(Size.X, Size.Y, Size.Z);
+		BoxElem.Center = RelativeTransform.TransformPosition(LocalBox.GetCenter());
+		BoxElem.Rotation = RelativeTransform.GetRotation().Rotator();
+		BodySetup->AggGeom.BoxElems.Add(BoxElem);
+	}
+	else if (CollisionFBXNode.CollisionShape == EglTFRuntimeFBXCollisionShape::Sphere)
+	{
+		const FVector LocalCenter = LocalBox.GetCenter();
+		float RadiusSquared = 0;
+		for (const FVector& Position : Positions)
+		{
+			RadiusSquared = FMath::Max<float>(RadiusSquared, FVector::DistSquared(Position, LocalCenter));
+		}
+		FKSphereElem SphereElem(FMath::Sqrt(RadiusSquared) * RelativeTransform.GetScale3D().GetAbsMax());
+		SphereElem.Center = RelativeTransform.TransformPosition(LocalCenter);
+		BodySetup->AggGeom.SphereElems.Add(SphereElem);
+	}
+	else
+	{
+		// the hull is computed when cooking, corners shared by multiple triangles are welded here
+		TSet<FVector> UniquePositions;
+		UniquePositions.Reserve(Positions.Num());
+
+		FKConvexElem ConvexElem;
+		for (const FVector& Position : Positions)
+		{
+			bool bAlreadyInSet = false;
+			UniquePositions.Add(Position, &bAlreadyInSet);
+			if (!bAlreadyInSet)
+			{
+				ConvexElem.VertexData.Add(RelativeTransform.TransformPosition(Position));
+			}
+		}
+		ConvexElem.UpdateElemBox();
+		BodySetup->AggGeom.ConvexElems.Add(ConvexElem);
+	}
+
+	return true;
+}
+
+USkeleton* UglTFRuntimeFBXFunctionLibrary::GetFBXSharedSkeleton(const FglTFRuntimeMeshLOD& RuntimeLOD)
+{
+	if (RuntimeLOD.Skeleton.Num() < 1)
+	{
+		return nullptr;
+	}
+
+	FScopeLock Lock(&glTFRuntimeFBX::SharedSkeletonsLock);
+
+	const uint32 BonesHash = glTFRuntimeFBX::GetBonesHash(RuntimeLOD.Skeleton);
+
+	USkeleton* FoundSkeleton = nullptr;
+	bool bHasStaleSkeletons = false;
+	for (TMultiMap<uint32, glTFRuntimeFBX::FSharedSkeleton>::TConstKeyIterator It = glTFRuntimeFBX::SharedSkeletons.CreateConstKeyIterator(BonesHash); It; ++It)
+	{
+		USkeleton* Skeleton = It.Value().Skeleton.Get();
+		if (!Skeleton)
+		{
+			bHasStaleSkeletons = true;
+			continue;
+		}
+
+		if (glTFRuntimeFBX::BonesAreEqual(It.Value().Bones, RuntimeLOD.Skeleton, true))
+		{
+			FoundSkeleton = Skeleton;
+			break;
+		}
+	}
+
+	// garbage collected skeletons
+	if (bHasStaleSkeletons)
+	{
+		for (TMultiMap<uint32, glTFRuntimeFBX::FSharedSkeleton>::TKeyIterator It = glTFRuntimeFBX::SharedSkeletons.CreateKeyIterator(BonesHash); It; ++It)
+		{
+			if (!It.Value().Skeleton.IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	return FoundSkeleton;
+}
+
+void UglTFRuntimeFBXFunctionLibrary::RegisterFBXSharedSkeleton(const FglTFRuntimeMeshLOD& RuntimeLOD, USkeleton* Skeleton)
+{
+	if (!Skeleton || RuntimeLOD.Skeleton.Num() < 1 || GetFBXSharedSkeleton(RuntimeLOD))
+	{
+		return;
+	}
+
+	FScopeLock Lock(&glTFRuntimeFBX::SharedSkeletonsLock);
+
+	glTFRuntimeFBX::FSharedSkeleton SharedSkeleton;
+	SharedSkeleton.Bones = RuntimeLOD.Skeleton;
+	SharedSkeleton.Skeleton = Skeleton;
+	glTFRuntimeFBX::SharedSkeletons.Add(glTFRuntimeFBX::GetBonesHash(RuntimeLOD.Skeleton), MoveTemp(SharedSkeleton));
+}
+
+bool UglTFRuntimeFBXFunctionLibrary::GetFBXRigidSkinBone(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode, FglTFRuntimeFBXNode& BoneFBXNode)
+{
+	if (!Asset)
+	{
+		return false;
+	}
+
+	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
+	{
+		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
+
+		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
+		if (!RuntimeFBXCacheData)
+		{
+			return false;
+		}
+	}
+
+	if (!RuntimeFBXCacheData->NodesMap.Contains(FBXNode.Id))
+	{
+		return false;
+	}
+
+	ufbx_skin_cluster* RigidCluster = glTFRuntimeFBX::GetRigidSkinCluster(RuntimeFBXCacheData->NodesMap[FBXNode.Id]->mesh);
+	if (!RigidCluster || !RigidCluster->bone_node)
+	{
+		return false;
+	}
+
+	glTFRuntimeFBX::FillNode(Asset, RigidCluster->bone_node, BoneFBXNode);
+	return true;
+}
+
+bool UglTFRuntimeFBXFunctionLibrary::GetFBXDefaultAnimation(UglTFRuntimeAsset* Asset, FglTFRuntimeFBXAnim& FBXAnim)
+{
+	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
+	{
+		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
+
+		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
+		if (!RuntimeFBXCacheData)
+		{
+			return false;
 		}
 	}
 
-	for (int32 NodeIndex = 0; NodeIndex < RuntimeFBXCacheData->Scene->nodes.count; NodeIndex++)
+	ufbx_anim* Anim = RuntimeFBXCacheData->Scene->anim;
+	if (Anim)
 	{
-		FglTFRuntimeFBXNode FBXNode;
-		ufbx_node* Node = RuntimeFBXCacheData->Scene->nodes.data[NodeIndex];
 
-		glTFRuntimeFBX::FillNode(Asset, Node, FBXNode);
+		for (int32 AnimStackIndex = 0; AnimStackIndex < RuntimeFBXCacheData->Scene->anim_stacks.count; AnimStackIndex++)
+		{
+			ufbx_anim_stack* AnimStack = RuntimeFBXCacheData->Scene->anim_stacks.data[AnimStackIndex];
 
-		Nodes.Add(MoveTemp(FBXNode));
+			if (AnimStack->anim == Anim)
+			{
+				FBXAnim.Id = AnimStack->element_id;
+				FBXAnim.Name = UTF8_TO_TCHAR(AnimStack->name.data);
+				FBXAnim.Duration = AnimStack->time_end - AnimStack->time_begin;
+				return true;
+			}
+		}
 	}
 
-	return Nodes;
+	return false;
 }
 
-TArray<FglTFRuntimeFBXNode> UglTFRuntimeFBXFunctionLibrary::GetFBXNodesMeshes(UglTFRuntimeAsset* Asset)
+TArray<FglTFRuntimeFBXAnim> UglTFRuntimeFBXFunctionLibrary::GetFBXAnimations(UglTFRuntimeAsset* Asset)
 {
-	TArray<FglTFRuntimeFBXNode> Nodes;
+	TArray<FglTFRuntimeFBXAnim> Anims;
 
 	if (!Asset)
 	{
-		return Nodes;
+		return Anims;
 	}
 
 	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
@@ -621,34 +3289,41 @@ TArray<FglTFRuntimeFBXNode> UglTFRuntimeFBXFunctionLibrary::GetFBXNodesMeshes(Ug
 		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
 		if (!RuntimeFBXCacheData)
 		{
-			return Nodes;
+			return Anims;
 		}
 	}
 
-	for (int32 NodeIndex = 0; NodeIndex < RuntimeFBXCacheData->Scene->nodes.count; NodeIndex++)
+	for (int32 AnimStackIndex = 0; AnimStackIndex < RuntimeFBXCacheData->Scene->anim_stacks.count; AnimStackIndex++)
 	{
-		FglTFRuntimeFBXNode FBXNode;
-		ufbx_node* Node = RuntimeFBXCacheData->Scene->nodes.data[NodeIndex];
-		if (!Node->mesh)
-		{
-			continue;
-		}
+		ufbx_anim_stack* AnimStack = RuntimeFBXCacheData->Scene->anim_stacks.data[AnimStackIndex];
 
-		glTFRuntimeFBX::FillNode(Asset, Node, FBXNode);
+		FglTFRuntimeFBXAnim FBXAnim;
+		FBXAnim.Id = AnimStack->element_id;
+		FBXAnim.Name = UTF8_TO_TCHAR(AnimStack->name.data);
+		FBXAnim.Duration = AnimStack->time_end - AnimStack->time_begin;
 
-		Nodes.Add(MoveTemp(FBXNode));
+		Anims.Add(MoveTemp(FBXAnim));
 	}
 
-	return Nodes;
+	return Anims;
 }
 
-FglTFRuntimeFBXNode UglTFRuntimeFBXFunctionLibrary::GetFBXRootNode(UglTFRuntimeAsset* Asset)
+UAnimSequence* UglTFRuntimeFBXFunctionLibrary::LoadFBXAnimAsSkeletalMeshAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, const FglTFRuntimeFBXNode& FBXNode, USkeletalMesh* SkeletalMesh, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, const FglTFRuntimeFBXAnimationConfig& AnimationConfig)
 {
-	FglTFRuntimeFBXNode FBXNode;
+	if (!Asset || !SkeletalMesh)
+	{
+		return nullptr;
+	}
 
-	if (!Asset)
+	return LoadFBXAnimAsSkeletalAnimation(Asset, FBXAnim, FBXNode, SkeletalMesh->GetSkeleton(), SkeletalAnimationConfig, AnimationConfig);
+}
+
+
+UAnimSequence* UglTFRuntimeFBXFunctionLibrary::LoadFBXAnimAsSkeletalAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, const FglTFRuntimeFBXNode& FBXNode, USkeleton* Skeleton, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, const FglTFRuntimeFBXAnimationConfig& AnimationConfig)
+{
+	if (!Asset || !Skeleton)
 	{
-		return FBXNode;
+		return nullptr;
 	}
 
 	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
@@ -658,56 +3333,103 @@ FglTFRuntimeFBXNode UglTFRuntimeFBXFunctionLibrary::GetFBXRootNode(UglTFRuntimeA
 		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
 		if (!RuntimeFBXCacheData)
 		{
-			return FBXNode;
+			return nullptr;
 		}
 	}
 
-	glTFRuntimeFBX::FillNode(Asset, RuntimeFBXCacheData->Scene->root_node, FBXNode);
-
-	return FBXNode;
-}
+	if (!RuntimeFBXCacheData->NodesMap.Contains(FBXNode.Id))
+	{
+		return nullptr;
+	}
 
-TArray<FglTFRuntimeFBXNode> UglTFRuntimeFBXFunctionLibrary::GetFBXNodeChildren(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode)
-{
-	TArray<FglTFRuntimeFBXNode> Nodes;
+	ufbx_node* FoundNode = RuntimeFBXCacheData->NodesMap[FBXNode.Id];
 
-	if (!Asset)
+	if (!FoundNode || !FoundNode->mesh || (FoundNode->mesh->skin_deformers.count < 1 && FoundNode->mesh->blend_deformers.count < 1))
 	{
-		return Nodes;
+		return nullptr;
 	}
 
-	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
+	ufbx_anim_stack* FoundAnim = nullptr;
+
+	for (int32 AnimStackIndex = 0; AnimStackIndex < RuntimeFBXCacheData->Scene->anim_stacks.count; AnimStackIndex++)
 	{
-		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
+		ufbx_anim_stack* AnimStack = RuntimeFBXCacheData->Scene->anim_stacks.data[AnimStackIndex];
 
-		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
-		if (!RuntimeFBXCacheData)
+		if (AnimStack->element_id == FBXAnim.Id)
 		{
-			return Nodes;
+			FoundAnim = AnimStack;
+			break;
 		}
 	}
 
-	if (RuntimeFBXCacheData->NodesMap.Contains(FBXNode.Id))
+	if (!FoundAnim)
 	{
-		for (uint32 ChildNodeIndex = 0; ChildNodeIndex < RuntimeFBXCacheData->NodesMap[FBXNode.Id]->children.count; ChildNodeIndex++)
-		{
-			FglTFRuntimeFBXNode ChildFBXNode;
-			ufbx_node* Node = RuntimeFBXCacheData->NodesMap[FBXNode.Id]->children.data[ChildNodeIndex];
+		return nullptr;
+	}
 
-			glTFRuntimeFBX::FillNode(Asset, Node, ChildFBXNode);
+	const FglTFRuntimeFBXAnimSequenceKey AnimSequenceKey = glTFRuntimeFBX::GetAnimSequenceKey(EglTFRuntimeFBXAnimSource::Node, FoundAnim->element_id, FBXNode.Id, Skeleton, SkeletalAnimationConfig, AnimationConfig);
+	if (UAnimSequence* CachedAnimSequence = glTFRuntimeFBX::GetCachedAnimSequence(RuntimeFBXCacheData.ToSharedRef(), AnimSequenceKey, SkeletalAnimationConfig.CacheMode))
+	{
+		return CachedAnimSequence;
+	}
 
-			Nodes.Add(MoveTemp(ChildFBXNode));
+	ufbx_baked_anim* BakedAnim = glTFRuntimeFBX::GetBakedAnim(RuntimeFBXCacheData.ToSharedRef(), FoundAnim, SkeletalAnimationConfig.FramesPerSecond);
+	if (!BakedAnim)
+	{
+		return nullptr;
+	}
+
+	const float Duration = FoundAnim->time_end - FoundAnim->time_begin;
+	const int32 NumFrames = SkeletalAnimationConfig.FramesPerSecond * Duration;
+	const float Delta = Duration / NumFrames;
+
+	FglTFRuntimePoseTracksMap PosesMap;
+	TMap<FName, TArray<TPair<float, float>>> MorphTargetCurves;
+
+	const int32 BonesNum = Skeleton->GetReferenceSkeleton().GetNum();
+
+	TArray<TPair<FString, ufbx_node*>> BoneNodes;
+	for (int32 BoneIndex = 0; BoneIndex < BonesNum; BoneIndex++)
+	{
+		const FString BoneName = Skeleton->GetReferenceSkeleton().GetBoneName(BoneIndex).ToString();
+
+		if (!RuntimeFBXCacheData->NodesNamesMap.Contains(BoneName))
+		{
+			continue;
 		}
+
+		BoneNodes.Add(TPair<FString, ufbx_node*>(BoneName, RuntimeFBXCacheData->NodesNamesMap[BoneName]));
 	}
 
-	return Nodes;
+	glTFRuntimeFBX::SampleBakedNodes(Asset, BakedAnim, BoneNodes, FoundAnim->time_begin, Delta, NumFrames, PosesMap);
+
+	glTFRuntimeFBX::SampleBlendChannels(FoundAnim->anim, FoundNode->mesh, FoundAnim->time_begin, Delta, NumFrames, MorphTargetCurves);
+
+	glTFRuntimeFBX::ReducePoseTracks(PosesMap, AnimationConfig);
+	glTFRuntimeFBX::ReduceMorphTargetCurves(MorphTargetCurves, AnimationConfig);
+
+	UAnimSequence* AnimSequence = Asset->GetParser()->LoadSkeletalAnimationFromTracksAndMorphTargets(Skeleton, PosesMap, MorphTargetCurves, Duration, SkeletalAnimationConfig);
+
+	glTFRuntimeFBX::CacheAnimSequence(RuntimeFBXCacheData.ToSharedRef(), AnimSequenceKey, AnimSequence, SkeletalAnimationConfig.CacheMode);
+
+	return AnimSequence;
 }
 
-bool UglTFRuntimeFBXFunctionLibrary::GetFBXNodeParent(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode, FglTFRuntimeFBXNode& FBXParentNode)
+UAnimSequence* UglTFRuntimeFBXFunctionLibrary::LoadFBXExternalAnimAsSkeletalMeshAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, USkeletalMesh* SkeletalMesh, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, const FglTFRuntimeFBXAnimationConfig& AnimationConfig)
 {
-	if (!Asset)
+	if (!Asset || !SkeletalMesh)
 	{
-		return false;
+		return nullptr;
+	}
+
+	return LoadFBXExternalAnimAsSkeletalAnimation(Asset, FBXAnim, SkeletalMesh->GetSkeleton(), SkeletalAnimationConfig, AnimationConfig);
+}
+
+UAnimSequence* UglTFRuntimeFBXFunctionLibrary::LoadFBXExternalAnimAsSkeletalAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, USkeleton* Skeleton, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, const FglTFRuntimeFBXAnimationConfig& AnimationConfig)
+{
+	if (!Asset || !Skeleton)
+	{
+		return nullptr;
 	}
 
 	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
@@ -717,56 +3439,80 @@ bool UglTFRuntimeFBXFunctionLibrary::GetFBXNodeParent(UglTFRuntimeAsset* Asset,
 		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
 		if (!RuntimeFBXCacheData)
 		{
-			return false;
+			return nullptr;
 		}
 	}
 
-	if (RuntimeFBXCacheData->NodesMap.Contains(FBXNode.Id))
+	ufbx_anim_stack* FoundAnim = nullptr;
+
+	for (int32 AnimStackIndex = 0; AnimStackIndex < RuntimeFBXCacheData->Scene->anim_stacks.count; AnimStackIndex++)
 	{
-		ufbx_node* ParentNode = RuntimeFBXCacheData->NodesMap[FBXNode.Id]->parent;
-		if (!ParentNode)
+		ufbx_anim_stack* AnimStack = RuntimeFBXCacheData->Scene->anim_stacks.data[AnimStackIndex];
+
+		if (AnimStack->element_id == FBXAnim.Id)
 		{
-			return false;
+			FoundAnim = AnimStack;
+			break;
 		}
-
-		glTFRuntimeFBX::FillNode(Asset, ParentNode, FBXParentNode);
-		return true;
 	}
 
-	return false;
-}
+	if (!FoundAnim)
+	{
+		return nullptr;
+	}
 
-bool UglTFRuntimeFBXFunctionLibrary::IsFBXNodeBone(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode)
-{
-	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
+	const FglTFRuntimeFBXAnimSequenceKey AnimSequenceKey = glTFRuntimeFBX::GetAnimSequenceKey(EglTFRuntimeFBXAnimSource::External, FoundAnim->element_id, 0, Skeleton, SkeletalAnimationConfig, AnimationConfig);
+	if (UAnimSequence* CachedAnimSequence = glTFRuntimeFBX::GetCachedAnimSequence(RuntimeFBXCacheData.ToSharedRef(), AnimSequenceKey, SkeletalAnimationConfig.CacheMode))
 	{
-		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
+		return CachedAnimSequence;
+	}
 
-		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
-		if (!RuntimeFBXCacheData)
-		{
-			return false;
-		}
+	ufbx_baked_anim* BakedAnim = glTFRuntimeFBX::GetBakedAnim(RuntimeFBXCacheData.ToSharedRef(), FoundAnim, SkeletalAnimationConfig.FramesPerSecond);
+	if (!BakedAnim)
+	{
+		return nullptr;
 	}
 
-	if (RuntimeFBXCacheData->NodesMap.Contains(FBXNode.Id))
+	const float Duration = FoundAnim->time_end - FoundAnim->time_begin;
+	const int32 NumFrames = SkeletalAnimationConfig.FramesPerSecond * Duration;
+	const float Delta = Duration / NumFrames;
+
+	FglTFRuntimePoseTracksMap PosesMap;
+	TMap<FName, TArray<TPair<float, float>>> MorphTargetCurves;
+
+	const int32 BonesNum = Skeleton->GetReferenceSkeleton().GetNum();
+
+	TArray<TPair<FString, ufbx_node*>> BoneNodes;
+	for (int32 BoneIndex = 0; BoneIndex < BonesNum; BoneIndex++)
 	{
-		ufbx_node* Node = RuntimeFBXCacheData->NodesMap[FBXNode.Id];
-		for (uint32 ClusterIndex = 0; ClusterIndex < RuntimeFBXCacheData->Scene->skin_clusters.count; ClusterIndex++)
+		const FString BoneName = Skeleton->GetReferenceSkeleton().GetBoneName(BoneIndex).ToString();
+
+		if (!RuntimeFBXCacheData->NodesNamesMap.Contains(BoneName))
 		{
-			ufbx_skin_cluster* Cluster = RuntimeFBXCacheData->Scene->skin_clusters.data[ClusterIndex];
-			if (Cluster->bone_node == Node)
-			{
-				return true;
-			}
+			continue;
 		}
+
+		BoneNodes.Add(TPair<FString, ufbx_node*>(BoneName, RuntimeFBXCacheData->NodesNamesMap[BoneName]));
 	}
 
-	return false;
+	glTFRuntimeFBX::SampleBakedNodes(Asset, BakedAnim, BoneNodes, FoundAnim->time_begin, Delta, NumFrames, PosesMap);
+
+	glTFRuntimeFBX::ReducePoseTracks(PosesMap, AnimationConfig);
+
+	UAnimSequence* AnimSequence = Asset->GetParser()->LoadSkeletalAnimationFromTracksAndMorphTargets(Skeleton, PosesMap, MorphTargetCurves, Duration, SkeletalAnimationConfig);
+
+	glTFRuntimeFBX::CacheAnimSequence(RuntimeFBXCacheData.ToSharedRef(), AnimSequenceKey, AnimSequence, SkeletalAnimationConfig.CacheMode);
+
+	return AnimSequence;
 }
 
-bool UglTFRuntimeFBXFunctionLibrary::GetFBXDefaultAnimation(UglTFRuntimeAsset* Asset, FglTFRuntimeFBXAnim& FBXAnim)
+UAnimSequence* UglTFRuntimeFBXFunctionLibrary::LoadFBXRawAnimAsSkeletalAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, USkeleton* Skeleton, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, const FglTFRuntimeFBXAnimationConfig& AnimationConfig)
 {
+	if (!Asset || !Skeleton)
+	{
+		return nullptr;
+	}
+
 	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
 	{
 		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
@@ -774,82 +3520,101 @@ bool UglTFRuntimeFBXFunctionLibrary::GetFBXDefaultAnimation(UglTFRuntimeAsset* A
 		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
 		if (!RuntimeFBXCacheData)
 		{
-			return false;
+			return nullptr;
 		}
 	}
 
-	ufbx_anim* Anim = RuntimeFBXCacheData->Scene->anim;
-	if (Anim)
+	ufbx_anim_stack* FoundAnim = nullptr;
+
+	for (int32 AnimStackIndex = 0; AnimStackIndex < RuntimeFBXCacheData->Scene->anim_stacks.count; AnimStackIndex++)
 	{
+		ufbx_anim_stack* AnimStack = RuntimeFBXCacheData->Scene->anim_stacks.data[AnimStackIndex];
 
-		for (int32 AnimStackIndex = 0; AnimStackIndex < RuntimeFBXCacheData->Scene->anim_stacks.count; AnimStackIndex++)
+		if (AnimStack->element_id == FBXAnim.Id)
 		{
-			ufbx_anim_stack* AnimStack = RuntimeFBXCacheData->Scene->anim_stacks.data[AnimStackIndex];
-
-			if (AnimStack->anim == Anim)
-			{
-				FBXAnim.Id = AnimStack->element_id;
-				FBXAnim.Name = UTF8_TO_TCHAR(AnimStack->name.data);
-				FBXAnim.Duration = AnimStack->time_end - AnimStack->time_begin;
-				return true;
-			}
+			FoundAnim = AnimStack;
+			break;
 		}
 	}
 
-	return false;
-}
+	if (!FoundAnim)
+	{
+		return nullptr;
+	}
 
-TArray<FglTFRuntimeFBXAnim> UglTFRuntimeFBXFunctionLibrary::GetFBXAnimations(UglTFRuntimeAsset* Asset)
-{
-	TArray<FglTFRuntimeFBXAnim> Anims;
+	const FglTFRuntimeFBXAnimSequenceKey AnimSequenceKey = glTFRuntimeFBX::GetAnimSequenceKey(EglTFRuntimeFBXAnimSource::Raw, FoundAnim->element_id, 0, Skeleton, SkeletalAnimationConfig, AnimationConfig);
+	if (UAnimSequence* CachedAnimSequence = glTFRuntimeFBX::GetCachedAnimSequence(RuntimeFBXCacheData.ToSharedRef(), AnimSequenceKey, SkeletalAnimationConfig.CacheMode))
+	{
+		return CachedAnimSequence;
+	}
+
+	ufbx_baked_anim* BakedAnim = glTFRuntimeFBX::GetBakedAnim(RuntimeFBXCacheData.ToSharedRef(), FoundAnim, SkeletalAnimationConfig.FramesPerSecond);
+	if (!BakedAnim)
+	{
+		return nullptr;
+	}
+
+	const float Duration = FoundAnim->time_end - FoundAnim->time_begin;
+	const int32 NumFrames = SkeletalAnimationConfig.FramesPerSecond * Duration;
+	const float Delta = Duration / NumFrames;
+
+	FglTFRuntimePoseTracksMap PosesMap;
+	TMap<FName, TArray<TPair<float, float>>> MorphTargetCurves;
+
+	TMap<FString, FTransform> RestTransforms;
 
-	if (!Asset)
+	TArray<TPair<FString, ufbx_node*>> BoneNodes;
+	for (const TPair<FString, ufbx_node*>& Pair : RuntimeFBXCacheData->NodesNamesMap)
 	{
-		return Anims;
+		RestTransforms.Add(Pair.Key, glTFRuntimeFBX::GetTransform(Asset, Pair.Value->local_transform));
+		BoneNodes.Add(Pair);
 	}
 
-	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
-	{
-		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
+	glTFRuntimeFBX::SampleBakedNodes(Asset, BakedAnim, BoneNodes, FoundAnim->time_begin, Delta, NumFrames, PosesMap);
 
-		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
-		if (!RuntimeFBXCacheData)
-		{
-			return Anims;
-		}
-	}
+	FglTFRuntimePoseTracksMap Tracks = Asset->GetParser()->FixupAnimationTracks(PosesMap, RestTransforms, SkeletalAnimationConfig);
 
-	for (int32 AnimStackIndex = 0; AnimStackIndex < RuntimeFBXCacheData->Scene->anim_stacks.count; AnimStackIndex++)
-	{
-		ufbx_anim_stack* AnimStack = RuntimeFBXCacheData->Scene->anim_stacks.data[AnimStackIndex];
+	glTFRuntimeFBX::ReducePoseTracks(Tracks, AnimationConfig);
 
-		FglTFRuntimeFBXAnim FBXAnim;
-		FBXAnim.Id = AnimStack->element_id;
-		FBXAnim.Name = UTF8_TO_TCHAR(AnimStack->name.data);
-		FBXAnim.Duration = AnimStack->time_end - AnimStack->time_begin;
+	UAnimSequence* AnimSequence = Asset->GetParser()->LoadSkeletalAnimationFromTracksAndMorphTargets(Skeleton, Tracks, MorphTargetCurves, Duration, SkeletalAnimationConfig);
 
-		Anims.Add(MoveTemp(FBXAnim));
-	}
+	glTFRuntimeFBX::CacheAnimSequence(RuntimeFBXCacheData.ToSharedRef(), AnimSequenceKey, AnimSequence, SkeletalAnimationConfig.CacheMode);
 
-	return Anims;
+	return AnimSequence;
 }
 
 UAnimSequence* UglTFRuntimeFBXFunctionLibrary::LoadFBXAnimAsSkeletalMeshAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, const FglTFRuntimeFBXNode& FBXNode, USkeletalMesh* SkeletalMesh, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig)
 {
-	if (!Asset || !SkeletalMesh)
-	{
-		return nullptr;
-	}
+	return LoadFBXAnimAsSkeletalMeshAnimation(Asset, FBXAnim, FBXNode, SkeletalMesh, SkeletalAnimationConfig, FglTFRuntimeFBXAnimationConfig());
+}
+
+UAnimSequence* UglTFRuntimeFBXFunctionLibrary::LoadFBXAnimAsSkeletalAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, const FglTFRuntimeFBXNode& FBXNode, USkeleton* Skeleton, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig)
+{
+	return LoadFBXAnimAsSkeletalAnimation(Asset, FBXAnim, FBXNode, Skeleton, SkeletalAnimationConfig, FglTFRuntimeFBXAnimationConfig());
+}
 
-	return LoadFBXAnimAsSkeletalAnimation(Asset, FBXAnim, FBXNode, SkeletalMesh->GetSkeleton(), SkeletalAnimationConfig);
+UAnimSequence* UglTFRuntimeFBXFunctionLibrary::LoadFBXExternalAnimAsSkeletalMeshAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, USkeletalMesh* SkeletalMesh, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig)
+{
+	return LoadFBXExternalAnimAsSkeletalMeshAnimation(Asset, FBXAnim, SkeletalMesh, SkeletalAnimationConfig, FglTFRuntimeFBXAnimationConfig());
 }
 
+UAnimSequence* UglTFRuntimeFBXFunctionLibrary::LoadFBXExternalAnimAsSkeletalAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, USkeleton* Skeleton, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig)
+{
+	return LoadFBXExternalAnimAsSkeletalAnimation(Asset, FBXAnim, Skeleton, SkeletalAnimationConfig, FglTFRuntimeFBXAnimationConfig());
+}
 
-UAnimSequence* UglTFRuntimeFBXFunctionLibrary::LoadFBXAnimAsSkeletalAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, const FglTFRuntimeFBXNode& FBXNode, USkeleton* Skeleton, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig)
+UAnimSequence* UglTFRuntimeFBXFunctionLibrary::LoadFBXRawAnimAsSkeletalAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, USkeleton* Skeleton, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig)
+{
+	return LoadFBXRawAnimAsSkeletalAnimation(Asset, FBXAnim, Skeleton, SkeletalAnimationConfig, FglTFRuntimeFBXAnimationConfig());
+}
+
+TMap<FString, UAnimSequence*> UglTFRuntimeFBXFunctionLibrary::LoadAllFBXAnimsAsSkeletalAnimations(UglTFRuntimeAsset* Asset, USkeleton* Skeleton, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, const FglTFRuntimeFBXAnimationConfig& AnimationConfig)
 {
+	TMap<FString, UAnimSequence*> AnimSequences;
+
 	if (!Asset || !Skeleton)
 	{
-		return nullptr;
+		return AnimSequences;
 	}
 
 	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
@@ -859,117 +3624,193 @@ UAnimSequence* UglTFRuntimeFBXFunctionLibrary::LoadFBXAnimAsSkeletalAnimation(Ug
 		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
 		if (!RuntimeFBXCacheData)
 		{
-			return nullptr;
+			return AnimSequences;
 		}
 	}
 
-	if (!RuntimeFBXCacheData->NodesMap.Contains(FBXNode.Id))
+	// the bones are resolved once for every stack
+	const int32 BonesNum = Skeleton->GetReferenceSkeleton().GetNum();
+
+	TArray<TPair<FString, ufbx_node*>> BoneNodes;
+	for (int32 BoneIndex = 0; BoneIndex < BonesNum; BoneIndex++)
 	{
-		return nullptr;
-	}
+		const FString BoneName = Skeleton->GetReferenceSkeleton().GetBoneName(BoneIndex).ToString();
 
-	ufbx_node* FoundNode = RuntimeFBXCacheData->NodesMap[FBXNode.Id];
+		if (!RuntimeFBXCacheData->NodesNamesMap.Contains(BoneName))
+		{
+			continue;
+		}
 
-	if (!FoundNode || !FoundNode->mesh || (FoundNode->mesh->skin_deformers.count < 1 && FoundNode->mesh->blend_deformers.count < 1))
-	{
-		return nullptr;
+		BoneNodes.Add(TPair<FString, ufbx_node*>(BoneName, RuntimeFBXCacheData->NodesNamesMap[BoneName]));
 	}
 
-	ufbx_anim_stack* FoundAnim = nullptr;
+	struct FStackTracks
+	{
+		ufbx_anim_stack* AnimStack = nullptr;
+		FString AnimName;
+		FglTFRuntimeFBXAnimSequenceKey AnimSequenceKey;
+		float Duration = 0;
+		FglTFRuntimePoseTracksMap PosesMap;
+		bool bSampled = false;
+	};
+
+	TArray<FStackTracks> StacksTracks;
+	TSet<FString> AnimNames;
 
 	for (int32 AnimStackIndex = 0; AnimStackIndex < RuntimeFBXCacheData->Scene->anim_stacks.count; AnimStackIndex++)
 	{
 		ufbx_anim_stack* AnimStack = RuntimeFBXCacheData->Scene->anim_stacks.data[AnimStackIndex];
 
-		if (AnimStack->element_id == FBXAnim.Id)
+		// empty and duplicated stack names would overwrite each other in the map
+		FString AnimName = UTF8_TO_TCHAR(AnimStack->name.data);
+		if (AnimName.IsEmpty() || AnimNames.Contains(AnimName))
 		{
-			FoundAnim = AnimStack;
-			break;
+			const FString BaseAnimName = AnimName.IsEmpty() ? FString::Printf(TEXT("Anim_%d"), AnimStackIndex) : AnimName;
+			FString UniqueAnimName = BaseAnimName;
+			for (int32 Suffix = 1; AnimNames.Contains(UniqueAnimName); Suffix++)
+			{
+				UniqueAnimName = FString::Printf(TEXT("%s_%d"), *BaseAnimName, Suffix);
+			}
+			UE_LOG(LogGLTFRuntime, Warning, TEXT("Anim stack %d name \"%s\" is empty or not unique, using \"%s\""), AnimStackIndex, *AnimName, *UniqueAnimName);
+			AnimName = UniqueAnimName;
 		}
-	}
+		AnimNames.Add(AnimName);
 
-	if (!FoundAnim)
-	{
-		return nullptr;
+		// same key of LoadFBXExternalAnimAsSkeletalAnimation, so the two functions share the cached sequences
+		FStackTracks StackTracks;
+		StackTracks.AnimStack = AnimStack;
+		StackTracks.AnimName = AnimName;
+		StackTracks.AnimSequenceKey = glTFRuntimeFBX::GetAnimSequenceKey(EglTFRuntimeFBXAnimSource::External, AnimStack->element_id, 0, Skeleton, SkeletalAnimationConfig, AnimationConfig);
+
+		if (UAnimSequence* CachedAnimSequence = glTFRuntimeFBX::GetCachedAnimSequence(RuntimeFBXCacheData.ToSharedRef(), StackTracks.AnimSequenceKey, SkeletalAnimationConfig.CacheMode))
+		{
+			AnimSequences.Add(AnimName, CachedAnimSequence);
+			continue;
+		}
+
+		StacksTracks.Add(MoveTemp(StackTracks));
 	}
 
-	const float Duration = FoundAnim->time_end - FoundAnim->time_begin;
-	const int32 NumFrames = SkeletalAnimationConfig.FramesPerSecond * Duration;
-	const float Delta = Duration / NumFrames;
+	ParallelFor(StacksTracks.Num(), [&](const int32 StackIndex)
+		{
+			FStackTracks& StackTracks = StacksTracks[StackIndex];
+			ufbx_anim_stack* AnimStack = StackTracks.AnimStack;
 
-	FglTFRuntimePoseTracksMap PosesMap;
-	TMap<FName, TArray<TPair<float, float>>> MorphTargetCurves;
+			StackTracks.Duration = AnimStack->time_end - AnimStack->time_begin;
+			const int32 NumFrames = SkeletalAnimationConfig.FramesPerSecond * StackTracks.Duration;
+			if (NumFrames < 1)
+			{
+				return;
+			}
 
-	const int32 BonesNum = Skeleton->GetReferenceSkeleton().GetNum();
+			const float Delta = StackTracks.Duration / NumFrames;
 
-	for (int32 BoneIndex = 0; BoneIndex < BonesNum; BoneIndex++)
-	{
-		const FString BoneName = Skeleton->GetReferenceSkeleton().GetBoneName(BoneIndex).ToString();
+			ufbx_baked_anim* BakedAnim = glTFRuntimeFBX::GetBakedAnim(RuntimeFBXCacheData.ToSharedRef(), AnimStack, SkeletalAnimationConfig.FramesPerSecond);
+			if (!BakedAnim)
+			{
+				return;
+			}
 
-		if (!RuntimeFBXCacheData->NodesNamesMap.Contains(BoneName))
+			glTFRuntimeFBX::SampleBakedNodes(Asset, BakedAnim, BoneNodes, AnimStack->time_begin, Delta, NumFrames, StackTracks.PosesMap);
+
+			glTFRuntimeFBX::ReducePoseTracks(StackTracks.PosesMap, AnimationConfig);
+
+			StackTracks.bSampled = true;
+		});
+
+	// UObjects are created on the calling thread
+	TMap<FName, TArray<TPair<float, float>>> MorphTargetCurves;
+	for (FStackTracks& StackTracks : StacksTracks)
+	{
+		if (!StackTracks.bSampled)
 		{
 			continue;
 		}
 
-		ufbx_node* BoneNode = RuntimeFBXCacheData->NodesNamesMap[BoneName];
-
-		float Time = FoundAnim->time_begin;
-
-		FRawAnimSequenceTrack Track;
-		for (int32 FrameIndex = 0; FrameIndex < NumFrames; FrameIndex++)
+		UAnimSequence* AnimSequence = Asset->GetParser()->LoadSkeletalAnimationFromTracksAndMorphTargets(Skeleton, StackTracks.PosesMap, MorphTargetCurves, StackTracks.Duration, SkeletalAnimationConfig);
+		if (!AnimSequence)
 		{
-			FTransform Transform = glTFRuntimeFBX::GetTransform(Asset, ufbx_evaluate_transform(FoundAnim->anim, BoneNode, Time));
-#if ENGINE_MAJOR_VERSION >= 5
-			Track.PosKeys.Add(FVector3f(Transform.GetLocation()));
-			Track.RotKeys.Add(FQuat4f(Transform.GetRotation()));
-			Track.ScaleKeys.Add(FVector3f(Transform.GetScale3D()));
-#else
-			Track.PosKeys.Add(Transform.GetLocation());
-			Track.RotKeys.Add(Transform.GetRotation());
-			Track.ScaleKeys.Add(Transform.GetScale3D());
-#endif
-			Time += Delta;
+			continue;
 		}
 
-		PosesMap.Add(BoneName, MoveTemp(Track));
+		glTFRuntimeFBX::CacheAnimSequence(RuntimeFBXCacheData.ToSharedRef(), StackTracks.AnimSequenceKey, AnimSequence, SkeletalAnimationConfig.CacheMode);
+
+		AnimSequences.Add(StackTracks.AnimName, AnimSequence);
 	}
 
-	for (uint32 BlendDeformerIndex = 0; BlendDeformerIndex < FoundNode->mesh->blend_deformers.count; BlendDeformerIndex++)
+	return AnimSequences;
+}
+
+bool UglTFRuntimeFBXFunctionLibrary::FillFBXSkinDeformer(UglTFRuntimeAsset* Asset, ufbx_skin_deformer* SkinDeformer, TArray<FglTFRuntimeBone>& Skeleton, TMap<uint32, TArray<TPair<int32, float>>>& JointsWeightsMap, int32& JointsWeightsGroups)
+{
+	TSet<FString> Bones;
+
+	ufbx_node* RootNode = nullptr;
+
+	TMap<FString, int32> BonesMap;
+
+	for (int32 ClusterIndex = 0; ClusterIndex < SkinDeformer->clusters.count; ClusterIndex++)
 	{
-		for (uint32 BlendDeformerChannelIndex = 0; BlendDeformerChannelIndex < FoundNode->mesh->blend_deformers.data[BlendDeformerIndex]->channels.count; BlendDeformerChannelIndex++)
+		ufbx_skin_cluster* Cluster = SkinDeformer->clusters.data[ClusterIndex];
+
+		if (!RootNode)
 		{
-			const FString MorphTargetName = UTF8_TO_TCHAR(FoundNode->mesh->blend_deformers.data[BlendDeformerIndex]->channels.data[BlendDeformerChannelIndex]->name.data);
-			float Time = FoundAnim->time_begin;
-			TArray<TPair<float, float>> MorphTargetValues;
-			for (int32 FrameIndex = 0; FrameIndex < NumFrames; FrameIndex++)
+			RootNode = Cluster->bone_node;
+			ufbx_node* Parent = RootNode->parent;
+			while (Parent && !Parent->is_root)
 			{
-				const float Weight = ufbx_evaluate_blend_weight(FoundAnim->anim, FoundNode->mesh->blend_deformers.data[BlendDeformerIndex]->channels.data[BlendDeformerChannelIndex], Time);
-				MorphTargetValues.Add(TPair<float, float>(Time, Weight));
-				Time += Delta;
+				RootNode = Parent;
+
+				Parent = Parent->parent;
 			}
 
-			MorphTargetCurves.Add(*MorphTargetName, MoveTemp(MorphTargetValues));
+			glTFRuntimeFBX::FillSkeleton(Asset, SkinDeformer, RootNode, Skeleton, BonesMap);
+		}
+
+		const FString BoneName = UTF8_TO_TCHAR(Cluster->bone_node->name.data);
+
+		if (BonesMap.Contains(BoneName))
+		{
+			const int32 BoneIndex = BonesMap[BoneName];
+
+			for (uint32 VertexIndex = 0; VertexIndex < Cluster->vertices.count; VertexIndex++)
+			{
+				const uint32 VertexIndexValue = Cluster->vertices.data[VertexIndex];
+				const float VertexWeight = Cluster->weights.data[VertexIndex];
+				if (!JointsWeightsMap.Contains(VertexIndexValue))
+				{
+					JointsWeightsMap.Add(VertexIndexValue);
+				}
+
+				JointsWeightsMap[VertexIndexValue].Add(TPair<int32, float>(BoneIndex, VertexWeight));
+			}
 		}
 	}
 
-	return Asset->GetParser()->LoadSkeletalAnimationFromTracksAndMorphTargets(Skeleton, PosesMap, MorphTargetCurves, Duration, SkeletalAnimationConfig);
-}
+	int32 MaxBoneInfluences = 4;
 
-UAnimSequence* UglTFRuntimeFBXFunctionLibrary::LoadFBXExternalAnimAsSkeletalMeshAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, USkeletalMesh* SkeletalMesh, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig)
-{
-	if (!Asset || !SkeletalMesh)
+	for (const TPair<uint32, TArray<TPair<int32, float>>>& Pair : JointsWeightsMap)
 	{
-		return nullptr;
+		if (Pair.Value.Num() > MaxBoneInfluences)
+		{
+			MaxBoneInfluences = Pair.Value.Num();
+		}
+	}
+
+	JointsWeightsGroups = MaxBoneInfluences / 4;
+	if (MaxBoneInfluences % 4 != 0)
+	{
+		JointsWeightsGroups++;
 	}
 
-	return LoadFBXExternalAnimAsSkeletalAnimation(Asset, FBXAnim, SkeletalMesh->GetSkeleton(), SkeletalAnimationConfig);
+	return true;
 }
 
-UAnimSequence* UglTFRuntimeFBXFunctionLibrary::LoadFBXExternalAnimAsSkeletalAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, USkeleton* Skeleton, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig)
+bool UglTFRuntimeFBXFunctionLibrary::LoadFBXAsRuntimeLODByNode(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode, FglTFRuntimeMeshLOD& RuntimeLOD, bool& bIsSkeletal, const FglTFRuntimeMaterialsConfig& StaticMeshMaterialsConfig, const FglTFRuntimeMaterialsConfig& SkeletalMeshMaterialsConfig, const FglTFRuntimeFBXMeshConfig& MeshConfig)
 {
-	if (!Asset || !Skeleton)
+	if (!Asset)
 	{
-		return nullptr;
+		return false;
 	}
 
 	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
@@ -979,77 +3820,117 @@ UAnimSequence* UglTFRuntimeFBXFunctionLibrary::LoadFBXExternalAnimAsSkeletalAnim
 		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
 		if (!RuntimeFBXCacheData)
 		{
-			return nullptr;
+			return false;
 		}
 	}
 
-	ufbx_anim_stack* FoundAnim = nullptr;
+	if (!RuntimeFBXCacheData->NodesMap.Contains(FBXNode.Id))
+	{
+		return false;
+	}
 
-	for (int32 AnimStackIndex = 0; AnimStackIndex < RuntimeFBXCacheData->Scene->anim_stacks.count; AnimStackIndex++)
+	RuntimeLOD.Empty();
+
+	ufbx_node* Node = RuntimeFBXCacheData->NodesMap[FBXNode.Id];
+
+	ufbx_mesh* Mesh = Node->mesh;
+	if (!Mesh)
 	{
-		ufbx_anim_stack* AnimStack = RuntimeFBXCacheData->Scene->anim_stacks.data[AnimStackIndex];
+		return false;
+	}
 
-		if (AnimStack->element_id == FBXAnim.Id)
+	// static meshes share the empty skin data
+	static const FglTFRuntimeFBXSkinDeformerData EmptySkinDeformerData;
+	TSharedPtr<const FglTFRuntimeFBXSkinDeformerData> SkinDeformerData;
+
+	ufbx_skin_cluster* RigidCluster = MeshConfig.bDemoteRigidSkins ? glTFRuntimeFBX::GetRigidSkinCluster(Mesh) : nullptr;
+
+	// skeletal mesh ?
+	if (Mesh->skin_deformers.count > 0 && !RigidCluster)
+	{
+		SkinDeformerData = glTFRuntimeFBX::GetMeshSkinDeformerData(Asset, RuntimeFBXCacheData.ToSharedRef(), Mesh);
+		if (!SkinDeformerData)
 		{
-			FoundAnim = AnimStack;
-			break;
+			return false;
 		}
+		RuntimeLOD.Skeleton = SkinDeformerData->Skeleton;
 	}
 
-	if (!FoundAnim)
-	{
-		return nullptr;
-	}
+	const FglTFRuntimeFBXSkinDeformerData& MeshSkinDeformerData = SkinDeformerData ? *SkinDeformerData : EmptySkinDeformerData;
+	const TMap<uint32, TArray<TPair<int32, float>>>& JointsWeightsMap = MeshSkinDeformerData.JointsWeightsMap;
+	const int32 JointsWeightsGroups = MeshSkinDeformerData.JointsWeightsGroups;
 
-	const float Duration = FoundAnim->time_end - FoundAnim->time_begin;
-	const int32 NumFrames = SkeletalAnimationConfig.FramesPerSecond * Duration;
-	const float Delta = Duration / NumFrames;
+	bIsSkeletal = JointsWeightsMap.Num() > 0;
 
-	FglTFRuntimePoseTracksMap PosesMap;
-	TMap<FName, TArray<TPair<float, float>>> MorphTargetCurves;
+	const FglTFRuntimeMaterialsConfig* MaterialsConfig = &StaticMeshMaterialsConfig;
 
-	const int32 BonesNum = Skeleton->GetReferenceSkeleton().GetNum();
+	if (bIsSkeletal)
+	{
+		MaterialsConfig = &SkeletalMeshMaterialsConfig;
+	}
 
-	for (int32 BoneIndex = 0; BoneIndex < BonesNum; BoneIndex++)
+	glTFRuntimeFBX::FGeneratedNormals GeneratedNormals;
+	ufbx_node* PrimitivesNode = Node;
+	if (MeshConfig.bGenerateMissingNormals)
 	{
-		const FString BoneName = Skeleton->GetReferenceSkeleton().GetBoneName(BoneIndex).ToString();
+		PrimitivesNode = glTFRuntimeFBX::GenerateMissingNormals(Node, GeneratedNormals);
+	}
 
-		if (!RuntimeFBXCacheData->NodesNamesMap.Contains(BoneName))
-		{
-			continue;
-		}
+	// rigid skins become static meshes in the space of their bone
+	ufbx_node RigidNode;
+	if (RigidCluster)
+	{
+		RigidNode = *PrimitivesNode;
+		RigidNode.geometry_transform = ufbx_matrix_to_transform(&RigidCluster->geometry_to_bone);
+		RigidNode.has_geometry_transform = true;
+		PrimitivesNode = &RigidNode;
+	}
 
-		ufbx_node* BoneNode = RuntimeFBXCacheData->NodesNamesMap[BoneName];
+	TArray<FglTFRuntimePrimitive> Primitives;
 
-		float Time = FoundAnim->time_begin;
+	if (!FillFBXPrimitives(Asset, RuntimeFBXCacheData, PrimitivesNode, 0, Primitives, JointsWeightsMap, JointsWeightsGroups, *MaterialsConfig))
+	{
+		return false;
+	}
 
-		FRawAnimSequenceTrack Track;
-		for (int32 FrameIndex = 0; FrameIndex < NumFrames; FrameIndex++)
+	// ensure only non-empty primitives are added
+	for (FglTFRuntimePrimitive& Primitive : Primitives)
+	{
+		if (Primitive.Indices.Num() > 0)
 		{
-			FTransform Transform = glTFRuntimeFBX::GetTransform(Asset, ufbx_evaluate_transform(FoundAnim->anim, BoneNode, Time));
-#if ENGINE_MAJOR_VERSION >= 5
-			Track.PosKeys.Add(FVector3f(Transform.GetLocation()));
-			Track.RotKeys.Add(FQuat4f(Transform.GetRotation()));
-			Track.ScaleKeys.Add(FVector3f(Transform.GetScale3D()));
-#else
-			Track.PosKeys.Add(Transform.GetLocation());
-			Track.RotKeys.Add(Transform.GetRotation());
-			Track.ScaleKeys.Add(Transform.GetScale3D());
-#endif
-			Time += Delta;
+			RuntimeLOD.Primitives.Add(MoveTemp(Primitive));
 		}
+	}
+
+	if (bIsSkeletal && MeshConfig.bPruneUnweightedBones)
+	{
+		TSet<FString> BonesToKeep(MeshConfig.BonesToKeep);
+		glTFRuntimeFBX::GetSocketBones(RuntimeFBXCacheData.ToSharedRef(), RuntimeLOD.Skeleton, BonesToKeep);
+		const int32 NumPrunedBones = glTFRuntimeFBX::PruneUnweightedBones(MakeArrayView(&RuntimeLOD, 1), BonesToKeep);
+		UE_LOG(LogGLTFRuntime, Log, TEXT("FBX Node %s: pruned %d unweighted bones"), *FBXNode.Name, NumPrunedBones);
+	}
 
-		PosesMap.Add(BoneName, MoveTemp(Track));
+	if (MeshConfig.bOptimizeVertexCache)
+	{
+		float ACMRBefore = 0;
+		float ACMRAfter = 0;
+		glTFRuntimeFBX::OptimizeRuntimeLOD(RuntimeLOD, MeshConfig.VertexCacheSize, ACMRBefore, ACMRAfter);
+		UE_LOG(LogGLTFRuntime, Log, TEXT("FBX Node %s vertex cache optimized: ACMR %f -> %f"), *FBXNode.Name, ACMRBefore, ACMRAfter);
 	}
 
-	return Asset->GetParser()->LoadSkeletalAnimationFromTracksAndMorphTargets(Skeleton, PosesMap, MorphTargetCurves, Duration, SkeletalAnimationConfig);
+	return true;
 }
 
-UAnimSequence* UglTFRuntimeFBXFunctionLibrary::LoadFBXRawAnimAsSkeletalAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, USkeleton* Skeleton, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig)
+bool UglTFRuntimeFBXFunctionLibrary::LoadFBXAsRuntimeLODByNode(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode, FglTFRuntimeMeshLOD& RuntimeLOD, bool& bIsSkeletal, const FglTFRuntimeMaterialsConfig& StaticMeshMaterialsConfig, const FglTFRuntimeMaterialsConfig& SkeletalMeshMaterialsConfig)
+{
+	return LoadFBXAsRuntimeLODByNode(Asset, FBXNode, RuntimeLOD, bIsSkeletal, StaticMeshMaterialsConfig, SkeletalMeshMaterialsConfig, FglTFRuntimeFBXMeshConfig());
+}
+
+bool UglTFRuntimeFBXFunctionLibrary::LoadFBXPosedNodeAsStaticRuntimeLOD(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode, const FglTFRuntimeFBXAnim& FBXAnim, const float Time, FglTFRuntimeMeshLOD& RuntimeLOD, const FglTFRuntimeMaterialsConfig& StaticMeshMaterialsConfig)
 {
-	if (!Asset || !Skeleton)
+	if (!Asset)
 	{
-		return nullptr;
+		return false;
 	}
 
 	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
@@ -1059,10 +3940,21 @@ UAnimSequence* UglTFRuntimeFBXFunctionLibrary::LoadFBXRawAnimAsSkeletalAnimation
 		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
 		if (!RuntimeFBXCacheData)
 		{
-			return nullptr;
+			return false;
 		}
 	}
 
+	if (!RuntimeFBXCacheData->NodesMap.Contains(FBXNode.Id))
+	{
+		return false;
+	}
+
+	ufbx_node* Node = RuntimeFBXCacheData->NodesMap[FBXNode.Id];
+	if (!Node->mesh)
+	{
+		return false;
+	}
+
 	ufbx_anim_stack* FoundAnim = nullptr;
 
 	for (int32 AnimStackIndex = 0; AnimStackIndex < RuntimeFBXCacheData->Scene->anim_stacks.count; AnimStackIndex++)
@@ -1078,118 +3970,226 @@ UAnimSequence* UglTFRuntimeFBXFunctionLibrary::LoadFBXRawAnimAsSkeletalAnimation
 
 	if (!FoundAnim)
 	{
-		return nullptr;
+		return false;
 	}
 
-	const float Duration = FoundAnim->time_end - FoundAnim->time_begin;
-	const int32 NumFrames = SkeletalAnimationConfig.FramesPerSecond * Duration;
-	const float Delta = Duration / NumFrames;
+	// skinning evaluation applies the blend shapes (ufbx_add_blend_vertex_offsets with the evaluated weights) before the skin deformer
+	ufbx_evaluate_opts EvaluateOptions = {};
+	EvaluateOptions.evaluate_skinning = true;
 
-	FglTFRuntimePoseTracksMap PosesMap;
-	TMap<FName, TArray<TPair<float, float>>> MorphTargetCurves;
+	ufbx_error Error;
+	ufbx_scene* PosedScene = ufbx_evaluate_scene(RuntimeFBXCacheData->Scene, FoundAnim->anim, FoundAnim->time_begin + Time, &EvaluateOptions, &Error);
+	if (!PosedScene)
+	{
+		UE_LOG(LogGLTFRuntime, Error, TEXT("Unable to evaluate FBX scene: %s"), UTF8_TO_TCHAR(Error.description.data));
+		return false;
+	}
 
-	TMap<FString, FTransform> RestTransforms;
+	ufbx_node* PosedNode = ufbx_as_node(PosedScene->elements.data[Node->element_id]);
+	if (!PosedNode || !PosedNode->mesh || !PosedNode->mesh->skinned_position.exists)
+	{
+		ufbx_free_scene(PosedScene);
+		return false;
+	}
 
-	for (const TPair<FString, ufbx_node*>& Pair : RuntimeFBXCacheData->NodesNamesMap)
+	// shallow copies exposing the posed vertices as the rest ones, materials come from the original scene for sharing the materials cache
+	ufbx_mesh PosedMesh = *PosedNode->mesh;
+	PosedMesh.vertex_position = PosedNode->mesh->skinned_position;
+	if (PosedNode->mesh->skinned_normal.exists)
+	{
+		PosedMesh.vertex_normal = PosedNode->mesh->skinned_normal;
+	}
+	PosedMesh.materials = Node->mesh->materials;
+	PosedMesh.blend_deformers.data = nullptr;
+	PosedMesh.blend_deformers.count = 0;
+
+	ufbx_node PosedMeshNode = *Node;
+	PosedMeshNode.mesh = &PosedMesh;
+
+	// skinned vertices are in world space, bring them back to the space of the node
+	if (!PosedNode->mesh->skinned_is_local)
 	{
-		const FString BoneName = Pair.Key;
+		const ufbx_matrix WorldToNode = ufbx_matrix_invert(&Node->node_to_world);
+		PosedMeshNode.geometry_transform = ufbx_matrix_to_transform(&WorldToNode);
+		PosedMeshNode.has_geometry_transform = true;
+	}
 
-		ufbx_node* BoneNode = Pair.Value;
+	RuntimeLOD.Empty();
 
-		float Time = FoundAnim->time_begin;
+	TArray<FglTFRuntimePrimitive> Primitives;
+	TMap<uint32, TArray<TPair<int32, float>>> EmptyJointsWeightsMap;
 
-		RestTransforms.Add(BoneName, glTFRuntimeFBX::GetTransform(Asset, BoneNode->local_transform));
+	const bool bSuccess = FillFBXPrimitives(Asset, RuntimeFBXCacheData, &PosedMeshNode, 0, Primitives, EmptyJointsWeightsMap, 1, StaticMeshMaterialsConfig);
 
-		FRawAnimSequenceTrack Track;
-		for (int32 FrameIndex = 0; FrameIndex < NumFrames; FrameIndex++)
-		{
-			FTransform Transform = glTFRuntimeFBX::GetTransform(Asset, ufbx_evaluate_transform(FoundAnim->anim, BoneNode, Time));
-#if ENGINE_MAJOR_VERSION >= 5
-			Track.PosKeys.Add(FVector3f(Transform.GetLocation()));
-			Track.RotKeys.Add(FQuat4f(Transform.GetRotation()));
-			Track.ScaleKeys.Add(FVector3f(Transform.GetScale3D()));
-#else
-			Track.PosKeys.Add(Transform.GetLocation());
-			Track.RotKeys.Add(Transform.GetRotation());
-			Track.ScaleKeys.Add(Transform.GetScale3D());
-#endif
-			Time += Delta;
-		}
+	ufbx_free_scene(PosedScene);
 
-		PosesMap.Add(BoneName, MoveTemp(Track));
+	if (!bSuccess)
+	{
+		return false;
 	}
 
-	FglTFRuntimePoseTracksMap Tracks = Asset->GetParser()->FixupAnimationTracks(PosesMap, RestTransforms, SkeletalAnimationConfig);
+	for (FglTFRuntimePrimitive& Primitive : Primitives)
+	{
+		if (Primitive.Indices.Num() > 0)
+		{
+			RuntimeLOD.Primitives.Add(MoveTemp(Primitive));
+		}
+	}
 
-	return Asset->GetParser()->LoadSkeletalAnimationFromTracksAndMorphTargets(Skeleton, Tracks, MorphTargetCurves, Duration, SkeletalAnimationConfig);
+	return true;
 }
 
-bool UglTFRuntimeFBXFunctionLibrary::FillFBXSkinDeformer(UglTFRuntimeAsset* Asset, ufbx_skin_deformer* SkinDeformer, TArray<FglTFRuntimeBone>& Skeleton, TMap<uint32, TArray<TPair<int32, float>>>& JointsWeightsMap, int32& JointsWeightsGroups)
+bool UglTFRuntimeFBXFunctionLibrary::LoadFBXLODGroupAsRuntimeLODs(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode, TArray<FglTFRuntimeMeshLOD>& RuntimeLODs, TArray<float>& ScreenSizes, bool& bIsSkeletal, const FglTFRuntimeMaterialsConfig& StaticMeshMaterialsConfig, const FglTFRuntimeMaterialsConfig& SkeletalMeshMaterialsConfig, const FglTFRuntimeFBXMeshConfig& MeshConfig)
 {
-	TSet<FString> Bones;
+	if (!Asset)
+	{
+		return false;
+	}
 
-	ufbx_node* RootNode = nullptr;
+	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
+	{
+		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
 
-	TMap<FString, int32> BonesMap;
+		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
+		if (!RuntimeFBXCacheData)
+		{
+			return false;
+		}
+	}
 
-	for (int32 ClusterIndex = 0; ClusterIndex < SkinDeformer->clusters.count; ClusterIndex++)
+	if (!RuntimeFBXCacheData->NodesMap.Contains(FBXNode.Id))
 	{
-		ufbx_skin_cluster* Cluster = SkinDeformer->clusters.data[ClusterIndex];
+		return false;
+	}
 
-		if (!RootNode)
-		{
-			RootNode = Cluster->bone_node;
-			ufbx_node* Parent = RootNode->parent;
-			while (Parent && !Parent->is_root)
-			{
-				RootNode = Parent;
+	ufbx_node* Node = RuntimeFBXCacheData->NodesMap[FBXNode.Id];
 
-				Parent = Parent->parent;
-			}
+	ufbx_lod_group* LODGroup = glTFRuntimeFBX::GetLODGroup(Node);
+	if (!LODGroup)
+	{
+		return false;
+	}
+
+	RuntimeLODs.Empty();
+	ScreenSizes.Empty();
+
+	const FTransform GroupWorldTransform = glTFRuntimeFBX::GetTransform(Asset, ufbx_matrix_to_transform(&Node->node_to_world));
+	float BoundsRadius = 0;
+
+	// levels must keep the same skeleton, bones are pruned after all of them have been loaded
+	// (and rigid skins are not demoted, levels are placed in the group space and must agree on being skeletal)
+	FglTFRuntimeFBXMeshConfig LevelMeshConfig = MeshConfig;
+	LevelMeshConfig.bPruneUnweightedBones = false;
+	LevelMeshConfig.bDemoteRigidSkins = false;
 
-			glTFRuntimeFBX::FillSkeleton(Asset, SkinDeformer, RootNode, INDEX_NONE, Skeleton, BonesMap);
+	// levels are matched in order with the node children
+	for (int32 LevelIndex = 0; LevelIndex < Node->children.count; LevelIndex++)
+	{
+		ufbx_node* MeshNode = glTFRuntimeFBX::FindFirstMeshNode(Node->children.data[LevelIndex]);
+		if (!MeshNode)
+		{
+			continue;
 		}
 
-		const FString BoneName = UTF8_TO_TCHAR(Cluster->bone_node->name.data);
+		FglTFRuntimeFBXNode FBXMeshNode;
+		glTFRuntimeFBX::FillNode(Asset, MeshNode, FBXMeshNode);
 
-		if (BonesMap.Contains(BoneName))
+		FglTFRuntimeMeshLOD RuntimeLOD;
+		bool bIsLevelSkeletal = false;
+		if (!LoadFBXAsRuntimeLODByNode(Asset, FBXMeshNode, RuntimeLOD, bIsLevelSkeletal, StaticMeshMaterialsConfig, SkeletalMeshMaterialsConfig, LevelMeshConfig))
 		{
-			const int32 BoneIndex = BonesMap[BoneName];
+			continue;
+		}
 
-			for (uint32 VertexIndex = 0; VertexIndex < Cluster->vertices.count; VertexIndex++)
+		if (RuntimeLODs.Num() == 0)
+		{
+			bIsSkeletal = bIsLevelSkeletal;
+		}
+		else if (bIsLevelSkeletal != bIsSkeletal)
+		{
+			UE_LOG(LogGLTFRuntime, Warning, TEXT("Skipping LOD level %s of %s: static and skeletal levels cannot be mixed"), *FBXMeshNode.Name, *FBXNode.Name);
+			continue;
+		}
+		else if (bIsSkeletal && !glTFRuntimeFBX::BonesAreEqual(RuntimeLODs[0].Skeleton, RuntimeLOD.Skeleton, true))
+		{
+			UE_LOG(LogGLTFRuntime, Warning, TEXT("Skipping LOD level %s of %s: incompatible skeleton"), *FBXMeshNode.Name, *FBXNode.Name);
+			continue;
+		}
+
+		// skinned vertices are already in skeleton space, static ones are expressed relative to the group node
+		if (!bIsSkeletal)
+		{
+			const FTransform RelativeTransform = glTFRuntimeFBX::GetTransform(Asset, ufbx_matrix_to_transform(&MeshNode->node_to_world)).GetRelativeTransform(GroupWorldTransform);
+			if (!RelativeTransform.Equals(FTransform::Identity))
 			{
-				const uint32 VertexIndexValue = Cluster->vertices.data[VertexIndex];
-				const float VertexWeight = Cluster->weights.data[VertexIndex];
-				if (!JointsWeightsMap.Contains(VertexIndexValue))
+				for (FglTFRuntimePrimitive& Primitive : RuntimeLOD.Primitives)
 				{
-					JointsWeightsMap.Add(VertexIndexValue);
+					glTFRuntimeFBX::TransformPrimitive(Primitive, RelativeTransform);
 				}
-
-				JointsWeightsMap[VertexIndexValue].Add(TPair<int32, float>(BoneIndex, VertexWeight));
 			}
 		}
-	}
 
-	int32 MaxBoneInfluences = 4;
+		if (RuntimeLODs.Num() == 0)
+		{
+			FBox Box(EForceInit::ForceInit);
+			for (const FglTFRuntimePrimitive& Primitive : RuntimeLOD.Primitives)
+			{
+				for (const FVector& Position : Primitive.Positions)
+				{
+					Box += Position;
+				}
+			}
+			BoundsRadius = Box.IsValid ? Box.GetExtent().Size() : 0;
+		}
 
-	for (const TPair<uint32, TArray<TPair<int32, float>>>& Pair : JointsWeightsMap)
-	{
-		if (Pair.Value.Num() > MaxBoneInfluences)
+		float ScreenSize = 1;
+		if (RuntimeLODs.Num() > 0 && LevelIndex < LODGroup->lod_levels.count)
 		{
-			MaxBoneInfluences = Pair.Value.Num();
+			const float Distance = LODGroup->lod_levels.data[LevelIndex].distance;
+			if (LODGroup->relative_distances)
+			{
+				ScreenSize = Distance / 100.0f;
+			}
+			else
+			{
+				// approximation of the engine screen size with a 90 degrees fov
+				const float WorldDistance = Asset->GetParser()->TransformPosition(FVector(Distance, 0, 0)).Size();
+				ScreenSize = WorldDistance > 0 ? BoundsRadius / WorldDistance : 1;
+			}
+			ScreenSize = FMath::Clamp(ScreenSize, 0.0f, ScreenSizes.Last());
 		}
+
+		RuntimeLODs.Add(MoveTemp(RuntimeLOD));
+		ScreenSizes.Add(ScreenSize);
 	}
 
-	JointsWeightsGroups = MaxBoneInfluences / 4;
-	if (MaxBoneInfluences % 4 != 0)
+	if (bIsSkeletal && MeshConfig.bPruneUnweightedBones && RuntimeLODs.Num() > 0)
 	{
-		JointsWeightsGroups++;
+		TSet<FString> BonesToKeep(MeshConfig.BonesToKeep);
+		glTFRuntimeFBX::GetSocketBones(RuntimeFBXCacheData.ToSharedRef(), RuntimeLODs[0].Skeleton, BonesToKeep);
+		const int32 NumPrunedBones = glTFRuntimeFBX::PruneUnweightedBones(RuntimeLODs, BonesToKeep);
+		UE_LOG(LogGLTFRuntime, Log, TEXT("FBX LOD Group %s: pruned %d unweighted bones"), *FBXNode.Name, NumPrunedBones);
 	}
 
-	return true;
+	return RuntimeLODs.Num() > 0;
 }
 
-bool UglTFRuntimeFBXFunctionLibrary::LoadFBXAsRuntimeLODByNode(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode, FglTFRuntimeMeshLOD& RuntimeLOD, bool& bIsSkeletal, const FglTFRuntimeMaterialsConfig& StaticMeshMaterialsConfig, const FglTFRuntimeMaterialsConfig& SkeletalMeshMaterialsConfig)
+void UglTFRuntimeFBXFunctionLibrary::GenerateFBXRuntimeLODs(const FglTFRuntimeMeshLOD& RuntimeLOD, const TArray<FglTFRuntimeFBXLODConfig>& LODsConfig, TArray<FglTFRuntimeMeshLOD>& RuntimeLODs)
+{
+	glTFRuntimeFBX::GenerateRuntimeLODChain(RuntimeLOD, LODsConfig, RuntimeLODs);
+}
+
+void UglTFRuntimeFBXFunctionLibrary::OptimizeFBXRuntimeLOD(FglTFRuntimeMeshLOD& RuntimeLOD, const int32 VertexCacheSize, float& ACMRBefore, float& ACMRAfter)
+{
+	glTFRuntimeFBX::OptimizeRuntimeLOD(RuntimeLOD, VertexCacheSize, ACMRBefore, ACMRAfter);
+}
+
+int32 UglTFRuntimeFBXFunctionLibrary::PruneFBXRuntimeLODBones(FglTFRuntimeMeshLOD& RuntimeLOD, const TArray<FString>& BonesToKeep)
+{
+	return glTFRuntimeFBX::PruneUnweightedBones(MakeArrayView(&RuntimeLOD, 1), TSet<FString>(BonesToKeep));
+}
+
+bool UglTFRuntimeFBXFunctionLibrary::MergeFBXRigidNodeIntoRuntimeLOD(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode, const FglTFRuntimeFBXNode& SkeletalFBXNode, FglTFRuntimeMeshLOD& RuntimeLOD, const FglTFRuntimeMaterialsConfig& SkeletalMeshMaterialsConfig, const FglTFRuntimeFBXMeshConfig& MeshConfig)
 {
 	if (!Asset)
 	{
@@ -1207,58 +4207,123 @@ bool UglTFRuntimeFBXFunctionLibrary::LoadFBXAsRuntimeLODByNode(UglTFRuntimeAsset
 		}
 	}
 
-	if (!RuntimeFBXCacheData->NodesMap.Contains(FBXNode.Id))
+	if (!RuntimeFBXCacheData->NodesMap.Contains(FBXNode.Id) || !RuntimeFBXCacheData->NodesMap.Contains(SkeletalFBXNode.Id))
 	{
 		return false;
 	}
 
-	RuntimeLOD.Empty();
-
 	ufbx_node* Node = RuntimeFBXCacheData->NodesMap[FBXNode.Id];
+	if (!Node->mesh || !Node->parent)
+	{
+		return false;
+	}
 
-	ufbx_mesh* Mesh = Node->mesh;
-	if (!Mesh)
+	// bone names are not unique across characters, the bone node must belong to the skeleton of the skeletal node (LOD groups use their first mesh)
+	ufbx_node* SkeletalMeshNode = glTFRuntimeFBX::FindFirstMeshNode(RuntimeFBXCacheData->NodesMap[SkeletalFBXNode.Id]);
+	if (!SkeletalMeshNode || !glTFRuntimeFBX::IsSkeletonBone(SkeletalMeshNode->mesh, Node->parent))
 	{
 		return false;
 	}
 
-	TMap<uint32, TArray<TPair<int32, float>>> JointsWeightsMap;
-	int32 JointsWeightsGroups = 1;
+	const FString BoneName = UTF8_TO_TCHAR(Node->parent->name.data);
+	const int32 BoneIndex = RuntimeLOD.Skeleton.IndexOfByPredicate([&BoneName](const FglTFRuntimeBone& Bone) { return Bone.BoneName == BoneName; });
+	if (BoneIndex == INDEX_NONE)
+	{
+		return false;
+	}
 
-	// skeletal mesh ?
-	if (Mesh->skin_deformers.count > 0)
+	FglTFRuntimeMeshLOD NodeLOD;
+	bool bIsSkeletal = false;
+	if (!LoadFBXAsRuntimeLODByNode(Asset, FBXNode, NodeLOD, bIsSkeletal, SkeletalMeshMaterialsConfig, SkeletalMeshMaterialsConfig, MeshConfig) || bIsSkeletal)
 	{
-		if (!FillFBXSkinDeformer(Asset, Mesh->skin_deformers.data[0], RuntimeLOD.Skeleton, JointsWeightsMap, JointsWeightsGroups))
-		{
-			return false;
-		}
+		return false;
 	}
 
-	bIsSkeletal = JointsWeightsMap.Num() > 0;
+	// the skeletal mesh space is the reference pose of the bone
+	FTransform BoneTransform = RuntimeLOD.Skeleton[BoneIndex].Transform;
+	int32 ParentIndex = RuntimeLOD.Skeleton[BoneIndex].ParentIndex;
+	while (RuntimeLOD.Skeleton.IsValidIndex(ParentIndex))
+	{
+		BoneTransform *= RuntimeLOD.Skeleton[ParentIndex].Transform;
+		ParentIndex = RuntimeLOD.Skeleton[ParentIndex].ParentIndex;
+	}
 
-	const FglTFRuntimeMaterialsConfig* MaterialsConfig = &StaticMeshMaterialsConfig;
+	const FTransform NodeTransform = FBXNode.Transform * BoneTransform;
 
-	if (bIsSkeletal)
+	const int32 JointsWeightsGroups = RuntimeLOD.Primitives.Num() > 0 ? FMath::Max(RuntimeLOD.Primitives[0].Joints.Num(), 1) : 1;
+
+	for (FglTFRuntimePrimitive& Primitive : NodeLOD.Primitives)
 	{
-		MaterialsConfig = &SkeletalMeshMaterialsConfig;
+		glTFRuntimeFBX::TransformPrimitive(Primitive, NodeTransform);
+
+		const int32 NumVertices = Primitive.Positions.Num();
+
+		Primitive.Joints.SetNum(JointsWeightsGroups);
+		Primitive.Weights.SetNum(JointsWeightsGroups);
+		for (int32 JWIndex = 0; JWIndex < JointsWeightsGroups; JWIndex++)
+		{
+			Primitive.Joints[JWIndex].Empty(NumVertices);
+			Primitive.Joints[JWIndex].AddZeroed(NumVertices);
+			Primitive.Weights[JWIndex].Empty(NumVertices);
+			Primitive.Weights[JWIndex].AddZeroed(NumVertices);
+		}
+
+		for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+		{
+			Primitive.Joints[0][VertexIndex][0] = BoneIndex;
+			Primitive.Weights[0][VertexIndex][0] = 1;
+		}
+
+		Primitive.bHighPrecisionWeights = true;
+
+		// batch with the sections sharing the same material
+		FglTFRuntimePrimitive* MergePrimitive = RuntimeLOD.Primitives.FindByPredicate([&Primitive](const FglTFRuntimePrimitive& CurrentPrimitive)
+			{
+				return glTFRuntimeFBX::CanMergeSkinnedPrimitives(CurrentPrimitive, Primitive);
+			});
+
+		if (MergePrimitive)
+		{
+			glTFRuntimeFBX::AppendSkinnedPrimitive(*MergePrimitive, Primitive);
+		}
+		else
+		{
+			RuntimeLOD.Primitives.Add(MoveTemp(Primitive));
+		}
 	}
 
-	TArray<FglTFRuntimePrimitive> Primitives;
+	return true;
+}
 
-	if (!FillFBXPrimitives(Asset, RuntimeFBXCacheData, Node, 0, Primitives, JointsWeightsMap, JointsWeightsGroups, *MaterialsConfig))
+bool UglTFRuntimeFBXFunctionLibrary::LoadFBXAsRuntimeLODClustersByNode(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode, TArray<FglTFRuntimeMeshLOD>& RuntimeLODs, bool& bIsSkeletal, const FglTFRuntimeMaterialsConfig& StaticMeshMaterialsConfig, const FglTFRuntimeMaterialsConfig& SkeletalMeshMaterialsConfig, const FglTFRuntimeFBXMeshConfig& MeshConfig)
+{
+	FglTFRuntimeMeshLOD RuntimeLOD;
+	if (!LoadFBXAsRuntimeLODByNode(Asset, FBXNode, RuntimeLOD, bIsSkeletal, StaticMeshMaterialsConfig, SkeletalMeshMaterialsConfig, MeshConfig))
 	{
 		return false;
 	}
 
-	// ensure only non-empty primitives are added
-	for (FglTFRuntimePrimitive& Primitive : Primitives)
+	// skinned meshes are bounded by their skeleton, splitting them would not help culling
+	if (bIsSkeletal || MeshConfig.ClusterMaxTriangles <= 0)
 	{
-		if (Primitive.Indices.Num() > 0)
-		{
-			RuntimeLOD.Primitives.Add(MoveTemp(Primitive));
-		}
+		RuntimeLODs.Add(MoveTemp(RuntimeLOD));
+		return true;
+	}
+
+	int32 NumTriangles = 0;
+	for (const FglTFRuntimePrimitive& Primitive : RuntimeLOD.Primitives)
+	{
+		NumTriangles += Primitive.Indices.Num() / 3;
+	}
+
+	if (NumTriangles <= MeshConfig.ClusterMaxTriangles)
+	{
+		RuntimeLODs.Add(MoveTemp(RuntimeLOD));
+		return true;
 	}
 
+	glTFRuntimeFBX::BuildClusteredRuntimeLODs(RuntimeLOD, MeshConfig.ClusterMaxTriangles, RuntimeLODs);
+
 	return true;
 }
 
@@ -1281,79 +4346,41 @@ bool UglTFRuntimeFBXFunctionLibrary::LoadAndMergeFBXAsRuntimeLODsGroupBySkinDefo
 		}
 	}
 
-	struct FglTFRuntimeFBXNodeToMerge
-	{
-		TArray<FglTFRuntimeBone> Skeleton;
-		TMap<uint32, TArray<TPair<int32, float>>> JointsWeightsMap;
-		int32 JointsWeightsGroups;
-	};
-
-	TArray< FglTFRuntimeFBXNodeToMerge> DiscoveredSkinDeformers;
+	TArray<TSharedPtr<const FglTFRuntimeFBXSkinDeformerData>> DiscoveredSkinDeformers;
 
 	for (int32 SkinDeformerIndex = 0; SkinDeformerIndex < RuntimeFBXCacheData->Scene->skin_deformers.count; SkinDeformerIndex++)
 	{
-		FglTFRuntimeFBXNodeToMerge CurrentSkinDeformer;
-		CurrentSkinDeformer.JointsWeightsGroups = 1;
-		if (!FillFBXSkinDeformer(Asset, RuntimeFBXCacheData->Scene->skin_deformers.data[SkinDeformerIndex], CurrentSkinDeformer.Skeleton, CurrentSkinDeformer.JointsWeightsMap, CurrentSkinDeformer.JointsWeightsGroups))
+		TSharedPtr<const FglTFRuntimeFBXSkinDeformerData> CurrentSkinDeformer = glTFRuntimeFBX::GetSkinDeformerData(Asset, RuntimeFBXCacheData.ToSharedRef(), RuntimeFBXCacheData->Scene->skin_deformers.data[SkinDeformerIndex]);
+		if (!CurrentSkinDeformer)
 		{
 			return false;
 		}
 
-		DiscoveredSkinDeformers.Add(MoveTemp(CurrentSkinDeformer));
+		DiscoveredSkinDeformers.Add(CurrentSkinDeformer);
 	}
 
-	auto SkinDeformerIsCompatible = [](const TArray<FglTFRuntimeBone>& BaseSkeleton, const TArray<FglTFRuntimeBone>& CurrentSkeleton)
-		{
-			if (BaseSkeleton.Num() != CurrentSkeleton.Num())
-			{
-				return false;
-			}
-
-			for (int32 BoneIndex = 0; BoneIndex < BaseSkeleton.Num(); BoneIndex++)
-			{
-				if (BaseSkeleton[BoneIndex].ParentIndex != CurrentSkeleton[BoneIndex].ParentIndex)
-				{
-					return false;
-				}
-
-				if (BaseSkeleton[BoneIndex].BoneName != CurrentSkeleton[BoneIndex].BoneName)
-				{
-					return false;
-				}
-			}
-
-			return true;
-		};
-
-	TSet<int32> ProcessedSkinDeformers;
+	// the first skin deformer of each group is stored by skeleton hash, collisions are solved by the full comparison
+	TMultiMap<uint32, int32> SkinDeformerGroupsByHash;
 	TArray<int32> SkinDeformerGroups;
 
 	for (int32 SkinDeformerIndex = 0; SkinDeformerIndex < DiscoveredSkinDeformers.Num(); SkinDeformerIndex++)
 	{
-		if (ProcessedSkinDeformers.Contains(SkinDeformerIndex))
-		{
-			continue;
-		}
+		const FglTFRuntimeFBXSkinDeformerData& CurrentSkinDeformer = *DiscoveredSkinDeformers[SkinDeformerIndex];
 
-		SkinDeformerGroups.Add(SkinDeformerIndex);
-		ProcessedSkinDeformers.Add(SkinDeformerIndex);
-
-		for (int32 CheckSkinDeformerIndex = 0; CheckSkinDeformerIndex < DiscoveredSkinDeformers.Num(); CheckSkinDeformerIndex++)
+		bool bHasGroup = false;
+		for (TMultiMap<uint32, int32>::TConstKeyIterator It = SkinDeformerGroupsByHash.CreateConstKeyIterator(CurrentSkinDeformer.SkeletonHash); It; ++It)
 		{
-			if (CheckSkinDeformerIndex == SkinDeformerIndex)
-			{
-				continue;
-			}
-
-			if (ProcessedSkinDeformers.Contains(CheckSkinDeformerIndex))
+			if (glTFRuntimeFBX::SkeletonsAreEqual(*DiscoveredSkinDeformers[It.Value()], CurrentSkinDeformer))
 			{
-				continue;
+				bHasGroup = true;
+				break;
 			}
+		}
 
-			if (SkinDeformerIsCompatible(DiscoveredSkinDeformers[SkinDeformerIndex].Skeleton, DiscoveredSkinDeformers[CheckSkinDeformerIndex].Skeleton))
-			{
-				ProcessedSkinDeformers.Add(CheckSkinDeformerIndex);
-			}
+		if (!bHasGroup)
+		{
+			SkinDeformerGroupsByHash.Add(CurrentSkinDeformer.SkeletonHash, SkinDeformerIndex);
+			SkinDeformerGroups.Add(SkinDeformerIndex);
 		}
 	}
 
@@ -1390,35 +4417,32 @@ bool UglTFRuntimeFBXFunctionLibrary::LoadAndMergeFBXAsRuntimeLODByBiggestSkinDef
 	struct FglTFRuntimeFBXNodeToMerge
 	{
 		FglTFRuntimeFBXNode FBXNode;
-		TArray<FglTFRuntimeBone> Skeleton;
-		TMap<uint32, TArray<TPair<int32, float>>> JointsWeightsMap;
-		int32 JointsWeightsGroups;
+		TSharedPtr<const FglTFRuntimeFBXSkinDeformerData> SkinDeformer;
 	};
 
 	int32 BiggestDeformerValue = -1;
 
-	TArray<FglTFRuntimeBone> BiggestSkeleton;
+	TSharedPtr<const FglTFRuntimeFBXSkinDeformerData> BiggestSkinDeformer;
 
 	for (int32 SkinDeformerIndex = 0; SkinDeformerIndex < RuntimeFBXCacheData->Scene->skin_deformers.count; SkinDeformerIndex++)
 	{
-		FglTFRuntimeFBXNodeToMerge CurrentSkinDeformer;
-		CurrentSkinDeformer.JointsWeightsGroups = 1;
-		if (FillFBXSkinDeformer(Asset, RuntimeFBXCacheData->Scene->skin_deformers.data[SkinDeformerIndex], CurrentSkinDeformer.Skeleton, CurrentSkinDeformer.JointsWeightsMap, CurrentSkinDeformer.JointsWeightsGroups))
+		TSharedPtr<const FglTFRuntimeFBXSkinDeformerData> CurrentSkinDeformer = glTFRuntimeFBX::GetSkinDeformerData(Asset, RuntimeFBXCacheData.ToSharedRef(), RuntimeFBXCacheData->Scene->skin_deformers.data[SkinDeformerIndex]);
+		if (CurrentSkinDeformer)
 		{
-			if (CurrentSkinDeformer.Skeleton.Num() > BiggestDeformerValue)
+			if (CurrentSkinDeformer->Skeleton.Num() > BiggestDeformerValue)
 			{
-				BiggestSkeleton = CurrentSkinDeformer.Skeleton;
-				BiggestDeformerValue = CurrentSkinDeformer.Skeleton.Num();
+				BiggestSkinDeformer = CurrentSkinDeformer;
+				BiggestDeformerValue = CurrentSkinDeformer->Skeleton.Num();
 			}
 		}
 	}
 
-	if (BiggestDeformerValue < 0 || BiggestSkeleton.Num() < 1)
+	if (BiggestDeformerValue < 0 || !BiggestSkinDeformer || BiggestSkinDeformer->Skeleton.Num() < 1)
 	{
 		return false;
 	}
 
-	RuntimeLOD.Skeleton = MoveTemp(BiggestSkeleton);
+	RuntimeLOD.Skeleton = BiggestSkinDeformer->Skeleton;
 
 	auto SkinDeformerIsCompatible = [](const TArray<FglTFRuntimeBone>& BaseSkeleton, const TArray<FglTFRuntimeBone>& CurrentSkeleton)
 		{
@@ -1476,14 +4500,12 @@ bool UglTFRuntimeFBXFunctionLibrary::LoadAndMergeFBXAsRuntimeLODByBiggestSkinDef
 
 		FglTFRuntimeFBXNodeToMerge FBXNodeToMerge;
 		FBXNodeToMerge.FBXNode = FBXNode;
-		FBXNodeToMerge.JointsWeightsGroups = 1;
-
-		if (!FillFBXSkinDeformer(Asset, Mesh->skin_deformers.data[0], FBXNodeToMerge.Skeleton, FBXNodeToMerge.JointsWeightsMap, FBXNodeToMerge.JointsWeightsGroups))
-		{
-			continue;
-		}
+		FBXNodeToMerge.SkinDeformer = glTFRuntimeFBX::GetCompatibleMeshSkinDeformerData(Asset, RuntimeFBXCacheData.ToSharedRef(), Mesh, [&](const FglTFRuntimeFBXSkinDeformerData& CurrentSkinDeformer)
+			{
+				return SkinDeformerIsCompatible(RuntimeLOD.Skeleton, CurrentSkinDeformer.Skeleton);
+			});
 
-		if (!SkinDeformerIsCompatible(RuntimeLOD.Skeleton, FBXNodeToMerge.Skeleton))
+		if (!FBXNodeToMerge.SkinDeformer)
 		{
 			continue;
 		}
@@ -1502,7 +4524,7 @@ bool UglTFRuntimeFBXFunctionLibrary::LoadAndMergeFBXAsRuntimeLODByBiggestSkinDef
 	{
 		ufbx_node* Node = RuntimeFBXCacheData->NodesMap[FBXNodeToMerge.FBXNode.Id];
 
-		if (!FillFBXPrimitives(Asset, RuntimeFBXCacheData, Node, Primitives.Num(), Primitives, FBXNodeToMerge.JointsWeightsMap, FBXNodeToMerge.JointsWeightsGroups, SkeletalMeshMaterialsConfig))
+		if (!FillFBXPrimitives(Asset, RuntimeFBXCacheData, Node, Primitives.Num(), Primitives, FBXNodeToMerge.SkinDeformer->JointsWeightsMap, FBXNodeToMerge.SkinDeformer->JointsWeightsGroups, SkeletalMeshMaterialsConfig))
 		{
 			return false;
 		}
@@ -1543,45 +4565,20 @@ bool UglTFRuntimeFBXFunctionLibrary::LoadAndMergeFBXAsRuntimeLODBySkinDeformer(U
 		return false;
 	}
 
-	TMap<uint32, TArray<TPair<int32, float>>> JointsWeightsMap;
-	int32 JointsWeightsGroups = 1;
-
-	if (!FillFBXSkinDeformer(Asset, RuntimeFBXCacheData->Scene->skin_deformers.data[SkinDeformerIndex], RuntimeLOD.Skeleton, JointsWeightsMap, JointsWeightsGroups))
+	TSharedPtr<const FglTFRuntimeFBXSkinDeformerData> SkinDeformerData = glTFRuntimeFBX::GetSkinDeformerData(Asset, RuntimeFBXCacheData.ToSharedRef(), RuntimeFBXCacheData->Scene->skin_deformers.data[SkinDeformerIndex]);
+	if (!SkinDeformerData)
 	{
 		return false;
 	}
 
+	RuntimeLOD.Skeleton = SkinDeformerData->Skeleton;
+
 	struct FglTFRuntimeFBXNodeToMerge
 	{
 		FglTFRuntimeFBXNode FBXNode;
-		TArray<FglTFRuntimeBone> Skeleton;
-		TMap<uint32, TArray<TPair<int32, float>>> JointsWeightsMap;
-		int32 JointsWeightsGroups;
+		TSharedPtr<const FglTFRuntimeFBXSkinDeformerData> SkinDeformer;
 	};
 
-	auto SkinDeformerIsCompatible = [](const TArray<FglTFRuntimeBone>& BaseSkeleton, const TArray<FglTFRuntimeBone>& CurrentSkeleton)
-		{
-			if (BaseSkeleton.Num() != CurrentSkeleton.Num())
-			{
-				return false;
-			}
-
-			for (int32 BoneIndex = 0; BoneIndex < BaseSkeleton.Num(); BoneIndex++)
-			{
-				if (BaseSkeleton[BoneIndex].ParentIndex != CurrentSkeleton[BoneIndex].ParentIndex)
-				{
-					return false;
-				}
-
-				if (BaseSkeleton[BoneIndex].BoneName != CurrentSkeleton[BoneIndex].BoneName)
-				{
-					return false;
-				}
-			}
-
-			return true;
-		};
-
 	const TArray<FglTFRuntimeFBXNode> FBXNodes = GetFBXNodesMeshes(Asset);
 
 	if (FBXNodes.Num() < 1)
@@ -1614,14 +4611,12 @@ bool UglTFRuntimeFBXFunctionLibrary::LoadAndMergeFBXAsRuntimeLODBySkinDeformer(U
 
 		FglTFRuntimeFBXNodeToMerge FBXNodeToMerge;
 		FBXNodeToMerge.FBXNode = FBXNode;
-		FBXNodeToMerge.JointsWeightsGroups = 1;
-
-		if (!FillFBXSkinDeformer(Asset, Mesh->skin_deformers.data[0], FBXNodeToMerge.Skeleton, FBXNodeToMerge.JointsWeightsMap, FBXNodeToMerge.JointsWeightsGroups))
-		{
-			continue;
-		}
+		FBXNodeToMerge.SkinDeformer = glTFRuntimeFBX::GetCompatibleMeshSkinDeformerData(Asset, RuntimeFBXCacheData.ToSharedRef(), Mesh, [&SkinDeformerData](const FglTFRuntimeFBXSkinDeformerData& CurrentSkinDeformer)
+			{
+				return glTFRuntimeFBX::SkeletonsAreEqual(*SkinDeformerData, CurrentSkinDeformer);
+			});
 
-		if (!SkinDeformerIsCompatible(RuntimeLOD.Skeleton, FBXNodeToMerge.Skeleton))
+		if (!FBXNodeToMerge.SkinDeformer)
 		{
 			continue;
 		}
@@ -1640,7 +4635,7 @@ bool UglTFRuntimeFBXFunctionLibrary::LoadAndMergeFBXAsRuntimeLODBySkinDeformer(U
 	{
 		ufbx_node* Node = RuntimeFBXCacheData->NodesMap[FBXNodeToMerge.FBXNode.Id];
 
-		if (!FillFBXPrimitives(Asset, RuntimeFBXCacheData, Node, Primitives.Num(), Primitives, FBXNodeToMerge.JointsWeightsMap, FBXNodeToMerge.JointsWeightsGroups, SkeletalMeshMaterialsConfig))
+		if (!FillFBXPrimitives(Asset, RuntimeFBXCacheData, Node, Primitives.Num(), Primitives, FBXNodeToMerge.SkinDeformer->JointsWeightsMap, FBXNodeToMerge.SkinDeformer->JointsWeightsGroups, SkeletalMeshMaterialsConfig))
 		{
 			return false;
 		}
@@ -1659,7 +4654,246 @@ bool UglTFRuntimeFBXFunctionLibrary::LoadAndMergeFBXAsRuntimeLODBySkinDeformer(U
 
 }
 
-bool UglTFRuntimeFBXFunctionLibrary::FillFBXPrimitives(UglTFRuntimeAsset* Asset, TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData, struct ufbx_node* Node, const int32 PrimitiveBase, TArray<FglTFRuntimePrimitive>& Primitives, const TMap<uint32, TArray<TPair<int32, float>>>& JointsWeightsMap, const int32 JointsWeightsGroups, const FglTFRuntimeMaterialsConfig& MaterialsConfig)
+bool UglTFRuntimeFBXFunctionLibrary::LoadAndMergeFBXStaticNodesAsRuntimeLODs(UglTFRuntimeAsset* Asset, TArray<FglTFRuntimeMeshLOD>& RuntimeLODs, const FglTFRuntimeMaterialsConfig& StaticMeshMaterialsConfig, const float ClusterSize)
+{
+	if (!Asset)
+	{
+		return false;
+	}
+
+	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
+	{
+		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
+
+		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
+		if (!RuntimeFBXCacheData)
+		{
+			return false;
+		}
+	}
+
+	const TMap<uint32, TArray<TPair<int32, float>>> EmptyJointsWeightsMap;
+
+	TMap<FIntVector, int32> ClustersMap;
+	const int32 FirstLODIndex = RuntimeLODs.Num();
+
+	for (int32 NodeIndex = 0; NodeIndex < RuntimeFBXCacheData->Scene->nodes.count; NodeIndex++)
+	{
+		ufbx_node* Node = RuntimeFBXCacheData->Scene->nodes.data[NodeIndex];
+		if (!Node->mesh || Node->mesh->skin_deformers.count > 0)
+		{
+			continue;
+		}
+
+		// LOD levels would be rendered on top of each other
+		if (glTFRuntimeFBX::IsSecondaryLODLevel(Node))
+		{
+			continue;
+		}
+
+		// collision hulls are never rendered (see AddFBXCollisionToBodySetup)
+		FString CollisionOwnerName;
+		if (glTFRuntimeFBX::GetCollisionShape(UTF8_TO_TCHAR(Node->name.data), CollisionOwnerName) != EglTFRuntimeFBXCollisionShape::None)
+		{
+			continue;
+		}
+
+		// the world matrix is applied as is (a TRS decomposition would lose the shear of non-uniformly scaled hierarchies)
+		ufbx_node WorldNode = *Node;
+		WorldNode.has_geometry_transform = false;
+
+		TArray<FglTFRuntimePrimitive> NodePrimitives;
+		if (!FillFBXPrimitives(Asset, RuntimeFBXCacheData, &WorldNode, 0, NodePrimitives, EmptyJointsWeightsMap, 1, StaticMeshMaterialsConfig))
+		{
+			return false;
+		}
+
+		const FMatrix WorldMatrix = glTFRuntimeFBX::GetMatrix(Asset, Node->geometry_to_world);
+		for (FglTFRuntimePrimitive& Primitive : NodePrimitives)
+		{
+			glTFRuntimeFBX::TransformPrimitive(Primitive, WorldMatrix);
+		}
+
+		FBox NodeBox(EForceInit::ForceInit);
+		for (const FglTFRuntimePrimitive& Primitive : NodePrimitives)
+		{
+			for (const FVector& Position : Primitive.Positions)
+			{
+				NodeBox += Position;
+			}
+		}
+
+		if (!NodeBox.IsValid)
+		{
+			continue;
+		}
+
+		FIntVector ClusterKey = FIntVector::ZeroValue;
+		if (ClusterSize > 0)
+		{
+			const FVector Center = NodeBox.GetCenter();
+			ClusterKey = FIntVector(FMath::FloorToInt(Center.X / ClusterSize), FMath::FloorToInt(Center.Y / ClusterSize), FMath::FloorToInt(Center.Z / ClusterSize));
+		}
+
+		if (!ClustersMap.Contains(ClusterKey))
+		{
+			ClustersMap.Add(ClusterKey, RuntimeLODs.AddDefaulted());
+		}
+
+		FglTFRuntimeMeshLOD& RuntimeLOD = RuntimeLODs[ClustersMap[ClusterKey]];
+
+		// group by material
+		for (FglTFRuntimePrimitive& Primitive : NodePrimitives)
+		{
+			if (Primitive.Indices.Num() < 1)
+			{
+				continue;
+			}
+
+			Primitive.MorphTargets.Empty();
+
+			FglTFRuntimePrimitive* MergedPrimitive = RuntimeLOD.Primitives.FindByPredicate([&Primitive](const FglTFRuntimePrimitive& CurrentPrimitive)
+				{
+					return glTFRuntimeFBX::CanMergePrimitives(CurrentPrimitive, Primitive);
+				});
+
+			if (MergedPrimitive)
+			{
+				glTFRuntimeFBX::AppendPrimitive(*MergedPrimitive, Primitive);
+			}
+			else
+			{
+				RuntimeLOD.Primitives.Add(MoveTemp(Primitive));
+			}
+		}
+	}
+
+	return RuntimeLODs.Num() > FirstLODIndex;
+}
+
+TSharedPtr<FglTFRuntimeFBXGeometryCacheStream> UglTFRuntimeFBXFunctionLibrary::LoadFBXGeometryCacheStream(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode, FglTFRuntimeMeshLOD& RuntimeLOD, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const float FrameRate, const int32 RingBufferSize)
+{
+	if (!Asset)
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData = nullptr;
+	{
+		FScopeLock Lock(&(Asset->GetParser()->PluginsCacheDataLock));
+
+		RuntimeFBXCacheData = glTFRuntimeFBX::GetCacheData(Asset);
+		if (!RuntimeFBXCacheData)
+		{
+			return nullptr;
+		}
+	}
+
+	if (!RuntimeFBXCacheData->NodesMap.Contains(FBXNode.Id))
+	{
+		return nullptr;
+	}
+
+	ufbx_node* Node = RuntimeFBXCacheData->NodesMap[FBXNode.Id];
+	if (!Node->mesh || Node->mesh->cache_deformers.count < 1)
+	{
+		return nullptr;
+	}
+
+	ufbx_cache_deformer* CacheDeformer = Node->mesh->cache_deformers.data[0];
+	if (!CacheDeformer->file || CacheDeformer->file->filename.length < 1)
+	{
+		return nullptr;
+	}
+
+	// as for textures, only files at the same level of the fbx are allowed
+	if (Asset->GetParser()->GetBaseDirectory().IsEmpty())
+	{
+		UE_LOG(LogGLTFRuntime, Error, TEXT("Unable to load geometry cache for %s: unknown base directory"), *FBXNode.Name);
+		return nullptr;
+	}
+
+	const FString CacheFilename = Asset->GetParser()->GetBaseDirectory() / FPaths::GetCleanFilename(UTF8_TO_TCHAR(CacheDeformer->file->filename.data));
+	if (!FPaths::FileExists(CacheFilename))
+	{
+		UE_LOG(LogGLTFRuntime, Error, TEXT("Unable to find geometry cache %s"), *CacheFilename);
+		return nullptr;
+	}
+
+	// apply the same conversions of the scene geometry
+	ufbx_geometry_cache_opts Options = {};
+	Options.frames_per_second = RuntimeFBXCacheData->Scene->settings.frames_per_second;
+	Options.mirror_axis = RuntimeFBXCacheData->Scene->metadata.mirror_axis;
+	Options.use_scale_factor = true;
+	Options.scale_factor = RuntimeFBXCacheData->Scene->metadata.geometry_scale;
+
+	ufbx_error Error;
+	FTCHARToUTF8 UTF8CacheFilename(*CacheFilename);
+	ufbx_geometry_cache* GeometryCache = ufbx_load_geometry_cache_len(UTF8CacheFilename.Get(), UTF8CacheFilename.Length(), &Options, &Error);
+	if (!GeometryCache)
+	{
+		UE_LOG(LogGLTFRuntime, Error, TEXT("Unable to load geometry cache %s"), *CacheFilename);
+		return nullptr;
+	}
+
+	const ufbx_cache_channel* Channel = nullptr;
+	for (const ufbx_cache_channel& CacheChannel : GeometryCache->channels)
+	{
+		if (FCStringAnsi::Strcmp(CacheChannel.name.data, CacheDeformer->channel.data) == 0)
+		{
+			Channel = &CacheChannel;
+			break;
+		}
+
+		if (!Channel && (CacheChannel.interpretation == UFBX_CACHE_INTERPRETATION_POINTS || CacheChannel.interpretation == UFBX_CACHE_INTERPRETATION_VERTEX_POSITION))
+		{
+			Channel = &CacheChannel;
+		}
+	}
+
+	if (!Channel)
+	{
+		ufbx_free_geometry_cache(GeometryCache);
+		return nullptr;
+	}
+
+	// the cache replaces any deformation, so the mesh is always extracted as static
+	const TMap<uint32, TArray<TPair<int32, float>>> EmptyJointsWeightsMap;
+	TArray<FglTFRuntimePrimitive> Primitives;
+	TArray<TArray<uint32>> PrimitivesControlPoints;
+	if (!FillFBXPrimitives(Asset, RuntimeFBXCacheData, Node, 0, Primitives, EmptyJointsWeightsMap, 1, MaterialsConfig, &PrimitivesControlPoints))
+	{
+		ufbx_free_geometry_cache(GeometryCache);
+		return nullptr;
+	}
+
+	RuntimeLOD.Empty();
+	TArray<TArray<uint32>> SectionsControlPoints;
+	for (int32 PrimitiveIndex = 0; PrimitiveIndex < Primitives.Num(); PrimitiveIndex++)
+	{
+		if (Primitives[PrimitiveIndex].Indices.Num() > 0)
+		{
+			RuntimeLOD.Primitives.Add(MoveTemp(Primitives[PrimitiveIndex]));
+			SectionsControlPoints.Add(MoveTemp(PrimitivesControlPoints[PrimitiveIndex]));
+		}
+	}
+
+	// FillFBXPrimitives conversion of positions expressed as a single affine matrix, so the worker thread does not need the parser
+	const FTransform GeometryTransform = Node->has_geometry_transform ? glTFRuntimeFBX::GetTransform(Asset, Node->geometry_transform) : FTransform::Identity;
+	auto ConvertPosition = [&](const FVector& Position)
+		{
+			return GeometryTransform.TransformPosition(Asset->GetParser()->TransformPosition(Position));
+		};
+	const FVector Origin = ConvertPosition(FVector::ZeroVector);
+	const FMatrix PositionsTransform(ConvertPosition(FVector(1, 0, 0)) - Origin, ConvertPosition(FVector(0, 1, 0)) - Origin, ConvertPosition(FVector(0, 0, 1)) - Origin, Origin);
+
+	TSharedPtr<FglTFRuntimeFBXGeometryCacheStream> Stream = MakeShared<FglTFRuntimeFBXGeometryCacheStream>(GeometryCache, Channel, PositionsTransform, MoveTemp(SectionsControlPoints), FrameRate, RingBufferSize);
+	Stream->Start();
+
+	return Stream;
+}
+
+bool UglTFRuntimeFBXFunctionLibrary::FillFBXPrimitives(UglTFRuntimeAsset* Asset, TSharedPtr<FglTFRuntimeFBXCacheData> RuntimeFBXCacheData, struct ufbx_node* Node, const int32 PrimitiveBase, TArray<FglTFRuntimePrimitive>& Primitives, const TMap<uint32, TArray<TPair<int32, float>>>& JointsWeightsMap, const int32 JointsWeightsGroups, const FglTFRuntimeMaterialsConfig& MaterialsConfig, TArray<TArray<uint32>>* PrimitivesControlPoints)
 {
 	ufbx_mesh* Mesh = Node->mesh;
 	if (!Mesh)
@@ -1667,9 +4901,8 @@ bool UglTFRuntimeFBXFunctionLibrary::FillFBXPrimitives(UglTFRuntimeAsset* Asset,
 		return false;
 	}
 
-	uint32 NumTriangleIndices = Mesh->max_face_triangles * 3;
 	TArray<uint32> TriangleIndices;
-	TriangleIndices.AddUninitialized(NumTriangleIndices);
+	TriangleIndices.AddUninitialized(static_cast<int32>(Mesh->max_face_triangles * 3));
 
 	const bool bIsSkeletal = JointsWeightsMap.Num() > 0;
 
@@ -1699,7 +4932,8 @@ bool UglTFRuntimeFBXFunctionLibrary::FillFBXPrimitives(UglTFRuntimeAsset* Asset,
 
 		if (Node->materials.count > 0)
 		{
-			ufbx_material* MeshMaterial = Mesh->materials.data[PrimitiveIndex - PrimitiveBase];
+			// per instance materials (mesh materials are the ones of the first instance)
+			ufbx_material* MeshMaterial = Node->materials.data[PrimitiveIndex - PrimitiveBase];
 
 			if (!MaterialsConfig.bSkipLoad)
 			{
@@ -1731,97 +4965,111 @@ bool UglTFRuntimeFBXFunctionLibrary::FillFBXPrimitives(UglTFRuntimeAsset* Asset,
 		}
 	}
 
-	for (uint32 FaceIndex = 0; FaceIndex < Mesh->num_faces; FaceIndex++)
+	glTFRuntimeFBX::FVertexExtractionContext ExtractionContext;
+	ExtractionContext.Parser = Asset->GetParser().Get();
+	ExtractionContext.Mesh = Mesh;
+	ExtractionContext.JointsWeightsGroups = JointsWeightsGroups;
+	MorphTargets.GenerateValueArray(ExtractionContext.BlendShapes);
+
+	uint32 AttributesMask = 0;
+
+	if (bIsSkeletal)
 	{
-		uint32 MaterialIndex = 0;
-		if (FaceIndex < Mesh->face_material.count)
+		AttributesMask |= glTFRuntimeFBX::EVertexAttributes::Skeletal;
+		ExtractionContext.Transform = glTFRuntimeFBX::GetTransform(Asset, Node->local_transform);
+		ExtractionContext.VertexJointsWeights.AddZeroed(static_cast<int32>(Mesh->num_vertices));
+		for (const TPair<uint32, TArray<TPair<int32, float>>>& Pair : JointsWeightsMap)
 		{
-			MaterialIndex = Mesh->face_material.data[FaceIndex];
+			if (Pair.Key < Mesh->num_vertices)
+			{
+				ExtractionContext.VertexJointsWeights[Pair.Key] = &Pair.Value;
+			}
 		}
+	}
+	else if (Node->has_geometry_transform)
+	{
+		AttributesMask |= glTFRuntimeFBX::EVertexAttributes::GeometryTransform;
+		ExtractionContext.Transform = glTFRuntimeFBX::GetTransform(Asset, Node->geometry_transform);
+	}
 
-		if (Primitives.IsValidIndex(PrimitiveBase + MaterialIndex))
-		{
-			FglTFRuntimePrimitive& Primitive = Primitives[PrimitiveBase + MaterialIndex];
+	if (Mesh->vertex_normal.exists)
+	{
+		AttributesMask |= glTFRuntimeFBX::EVertexAttributes::Normals;
+	}
 
-			ufbx_face Face = Mesh->faces.data[FaceIndex];
-			uint32 NumTriangles = ufbx_triangulate_face(TriangleIndices.GetData(), NumTriangleIndices, Mesh, Face);
+	if (Mesh->vertex_uv.exists)
+	{
+		AttributesMask |= glTFRuntimeFBX::EVertexAttributes::UVs;
+	}
 
-			for (uint32 VertexIndex = 0; VertexIndex < NumTriangles * 3; VertexIndex++)
-			{
-				const uint32 Index = TriangleIndices[VertexIndex];
+	if (Mesh->vertex_color.exists)
+	{
+		AttributesMask |= glTFRuntimeFBX::EVertexAttributes::Colors;
+	}
 
-				if (bIsSkeletal)
-				{
-					for (int32 JWIndex = 0; JWIndex < JointsWeightsGroups; JWIndex++)
-					{
-						Primitive.Joints[JWIndex].AddZeroed();
-						Primitive.Weights[JWIndex].AddZeroed();
-					}
+	if (MorphTargets.Num() > 0)
+	{
+		AttributesMask |= glTFRuntimeFBX::EVertexAttributes::MorphTargets;
+	}
 
-					if (JointsWeightsMap.Contains(Mesh->vertex_indices.data[Index]))
-					{
-						const TArray<TPair<int32, float>>& JointsWeights = JointsWeightsMap[Mesh->vertex_indices.data[Index]];
-						int32 BoneIndex = 0;
-						for (const TPair<int32, float>& Pair : JointsWeights)
-						{
-							Primitive.Joints[BoneIndex / 4].Last()[BoneIndex % 4] = Pair.Key;
-							Primitive.Weights[BoneIndex / 4].Last()[BoneIndex % 4] = Pair.Value;
-							BoneIndex++;
-						}
-					}
-				}
+	const glTFRuntimeFBX::FVertexExtractor VertexExtractor = glTFRuntimeFBX::TVertexExtractorSelector<glTFRuntimeFBX::EVertexAttributes::All>::Select(AttributesMask);
 
-				const ufbx_vec3 Position = ufbx_get_vertex_vec3(&Mesh->vertex_position, Index);
+	// first collect the triangulated corners of each primitive, then run the specialized extractor on them
+	TArray<TArray<uint32>> PrimitivesCorners;
+	PrimitivesCorners.AddDefaulted(NumMaterials);
 
-				if (bIsSkeletal)
-				{
-					Primitive.Positions.Add(glTFRuntimeFBX::GetTransform(Asset, Node->local_transform).TransformPosition(Asset->GetParser()->TransformPosition(FVector(Position.x, Position.y, Position.z))));
-				}
-				else
-				{
-					if (Node->has_geometry_transform)
-					{
-						Primitive.Positions.Add(glTFRuntimeFBX::GetTransform(Asset, Node->geometry_transform).TransformPosition(Asset->GetParser()->TransformPosition(FVector(Position.x, Position.y, Position.z))));
-					}
-					else
-					{
-						Primitive.Positions.Add(Asset->GetParser()->TransformPosition(FVector(Position.x, Position.y, Position.z)));
-					}
-				}
+	if (Mesh->material_parts.count > 0)
+	{
+		// material parts already know their faces and triangles count
+		for (const ufbx_mesh_part& MeshPart : Mesh->material_parts)
+		{
+			if (!PrimitivesCorners.IsValidIndex(MeshPart.index))
+			{
+				continue;
+			}
 
-				for (FglTFRuntimeMorphTarget& MorphTarget : Primitive.MorphTargets)
-				{
-					ufbx_blend_shape* BlendShape = MorphTargets[MorphTarget.Name];
-					const ufbx_vec3 MorphTargetPosition = ufbx_get_blend_shape_vertex_offset(BlendShape, Mesh->vertex_indices.data[Index]);
-					MorphTarget.Positions.Add(Asset->GetParser()->TransformPosition(FVector(MorphTargetPosition.x, MorphTargetPosition.y, MorphTargetPosition.z)));
-				}
+			TArray<uint32>& Corners = PrimitivesCorners[MeshPart.index];
+			Corners.Reserve(static_cast<int32>(MeshPart.num_triangles * 3));
 
-				if (Mesh->vertex_normal.exists)
-				{
-					const ufbx_vec3 Normal = ufbx_get_vertex_vec3(&Mesh->vertex_normal, Index);
-					if (bIsSkeletal)
-					{
-						Primitive.Normals.Add(glTFRuntimeFBX::GetTransform(Asset, Node->local_transform).TransformVector(Asset->GetParser()->TransformVector(FVector(Normal.x, Normal.y, Normal.z))));
-					}
-					else
-					{
-						Primitive.Normals.Add(Asset->GetParser()->TransformVector(FVector(Normal.x, Normal.y, Normal.z)));
-					}
-				}
+			for (const uint32 FaceIndex : MeshPart.face_indices)
+			{
+				glTFRuntimeFBX::TriangulateFace(Mesh, Mesh->faces.data[FaceIndex], TriangleIndices, Corners);
+			}
+		}
+	}
+	else
+	{
+		for (uint32 FaceIndex = 0; FaceIndex < Mesh->num_faces; FaceIndex++)
+		{
+			uint32 MaterialIndex = 0;
+			if (FaceIndex < Mesh->face_material.count)
+			{
+				MaterialIndex = Mesh->face_material.data[FaceIndex];
+			}
 
-				if (Mesh->vertex_uv.exists)
-				{
-					const ufbx_vec2 UV = ufbx_get_vertex_vec2(&Mesh->vertex_uv, Index);
-					Primitive.UVs[0].Add(FVector2D(UV.x, 1 - UV.y));
-				}
+			if (PrimitivesCorners.IsValidIndex(MaterialIndex))
+			{
+				glTFRuntimeFBX::TriangulateFace(Mesh, Mesh->faces.data[FaceIndex], TriangleIndices, PrimitivesCorners[MaterialIndex]);
+			}
+		}
+	}
 
-				if (Mesh->vertex_color.exists)
-				{
-					const ufbx_vec4 Color = ufbx_get_vertex_vec4(&Mesh->vertex_color, Index);
-					Primitive.Colors.Add(FVector4(Color.x, Color.y, Color.z, Color.w));
-				}
+	for (uint32 MaterialIndex = 0; MaterialIndex < NumMaterials; MaterialIndex++)
+	{
+		VertexExtractor(ExtractionContext, PrimitivesCorners[MaterialIndex], Primitives[PrimitiveBase + MaterialIndex]);
+	}
 
-				Primitive.Indices.Add(Primitive.Positions.Num() - 1);
+	// map every extracted vertex to its control point (required for applying point caches)
+	if (PrimitivesControlPoints)
+	{
+		PrimitivesControlPoints->SetNum(Primitives.Num());
+		for (uint32 MaterialIndex = 0; MaterialIndex < NumMaterials; MaterialIndex++)
+		{
+			TArray<uint32>& ControlPoints = (*PrimitivesControlPoints)[PrimitiveBase + MaterialIndex];
+			ControlPoints.Reserve(ControlPoints.Num() + PrimitivesCorners[MaterialIndex].Num());
+			for (const uint32 Corner : PrimitivesCorners[MaterialIndex])
+			{
+				ControlPoints.Add(Mesh->vertex_indices.data[Corner]);
 			}
 		}
 	}
@@ -0,0 +1,127 @@
+// Copyright 2023-2024 - Roberto De Ioris
+
+#include "glTFRuntimeFBXGeometryCacheComponent.h"
+#include "glTFRuntimeFBXGeometryCacheStream.h"
+
+UglTFRuntimeFBXGeometryCacheComponent::UglTFRuntimeFBXGeometryCacheComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	bPlaying = true;
+	bLoop = true;
+	PlayRate = 1;
+	CurrentTime = 0;
+	FrameRate = 30;
+	RingBufferSize = 8;
+	CurrentFrame = INDEX_NONE;
+}
+
+bool UglTFRuntimeFBXGeometryCacheComponent::LoadFBXGeometryCache(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode, const FglTFRuntimeMaterialsConfig& MaterialsConfig)
+{
+	Stream.Reset();
+	ClearAllMeshSections();
+
+	FglTFRuntimeMeshLOD RuntimeLOD;
+	Stream = UglTFRuntimeFBXFunctionLibrary::LoadFBXGeometryCacheStream(Asset, FBXNode, RuntimeLOD, MaterialsConfig, FrameRate, RingBufferSize);
+	if (!Stream)
+	{
+		return false;
+	}
+
+	for (int32 SectionIndex = 0; SectionIndex < RuntimeLOD.Primitives.Num(); SectionIndex++)
+	{
+		const FglTFRuntimePrimitive& Primitive = RuntimeLOD.Primitives[SectionIndex];
+
+		TArray<int32> Triangles;
+		Triangles.Reserve(Primitive.Indices.Num());
+		for (const uint32 Index : Primitive.Indices)
+		{
+			Triangles.Add(Index);
+		}
+
+		TArray<FVector2D> UV0;
+		if (Primitive.UVs.Num() > 0)
+		{
+			UV0 = Primitive.UVs[0];
+		}
+
+		TArray<FColor> VertexColors;
+		VertexColors.Reserve(Primitive.Colors.Num());
+		for (const FVector4& Color : Primitive.Colors)
+		{
+			VertexColors.Add(FLinearColor(Color.X, Color.Y, Color.Z, Color.W).ToFColor(true));
+		}
+
+		TArray<FProcMeshTangent> Tangents;
+		Tangents.Reserve(Primitive.Tangents.Num());
+		for (const FVector4& Tangent : Primitive.Tangents)
+		{
+			Tangents.Add(FProcMeshTangent(FVector(Tangent.X, Tangent.Y, Tangent.Z), Tangent.W < 0));
+		}
+
+		CreateMeshSection(SectionIndex, Primitive.Positions, Triangles, Primitive.Normals, UV0, VertexColors, Tangents, false);
+		SetMaterial(SectionIndex, Primitive.Material);
+	}
+
+	CurrentFrame = INDEX_NONE;
+
+	return true;
+}
+
+float UglTFRuntimeFBXGeometryCacheComponent::GetDuration() const
+{
+	return Stream ? Stream->GetDuration() : 0;
+}
+
+void UglTFRuntimeFBXGeometryCacheComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!Stream || !bPlaying)
+	{
+		return;
+	}
+
+	const float Duration = Stream->GetDuration();
+
+	CurrentTime += DeltaTime * PlayRate;
+	if (bLoop && Duration > 0)
+	{
+		CurrentTime = FMath::Fmod(CurrentTime, Duration);
+		if (CurrentTime < 0)
+		{
+			CurrentTime += Duration;
+		}
+	}
+	else
+	{
+		CurrentTime = FMath::Clamp(CurrentTime, 0.0f, Duration);
+	}
+
+	const int32 Frame = FMath::Clamp(FMath::FloorToInt(CurrentTime * Stream->GetFrameRate()), 0, Stream->GetNumFrames() - 1);
+	if (Frame == CurrentFrame)
+	{
+		return;
+	}
+
+	// if the worker is late, keep the previous frame
+	if (!Stream->GetFrame(Frame, bLoop, SectionsPositions))
+	{
+		return;
+	}
+
+	// only positions are streamed, the other attributes keep the values of the first frame
+	for (int32 SectionIndex = 0; SectionIndex < SectionsPositions.Num(); SectionIndex++)
+	{
+		UpdateMeshSection(SectionIndex, SectionsPositions[SectionIndex], TArray<FVector>(), TArray<FVector2D>(), TArray<FColor>(), TArray<FProcMeshTangent>());
+	}
+
+	CurrentFrame = Frame;
+}
+
+void UglTFRuntimeFBXGeometryCacheComponent::OnComponentDestroyed(bool bDestroyingHierarchy)
+{
+	// stops the worker thread
+	Stream.Reset();
+
+	Super::OnComponentDestroyed(bDestroyingHierarchy);
+}
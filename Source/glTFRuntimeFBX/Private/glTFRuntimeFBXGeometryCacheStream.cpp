@@ -0,0 +1,197 @@
+// Copyright 2023-2024 - Roberto De Ioris
+
+#include "glTFRuntimeFBXGeometryCacheStream.h"
+#include "HAL/RunnableThread.h"
+THIRD_PARTY_INCLUDES_START
+#include "ufbx.h"
+THIRD_PARTY_INCLUDES_END
+
+FglTFRuntimeFBXGeometryCacheStream::FglTFRuntimeFBXGeometryCacheStream(ufbx_geometry_cache* InGeometryCache, const ufbx_cache_channel* InChannel, const FMatrix& InPositionsTransform, TArray<TArray<uint32>>&& InSectionsControlPoints, const float InFrameRate, const int32 InRingBufferSize)
+	: GeometryCache(InGeometryCache)
+	, Channel(InChannel)
+	, PositionsTransform(InPositionsTransform)
+	, SectionsControlPoints(MoveTemp(InSectionsControlPoints))
+	, NumControlPoints(0)
+	, StartTime(0)
+	, Duration(0)
+	, FrameRate(FMath::Max(InFrameRate, 1.0f))
+	, NumFrames(1)
+	, RequestedFrame(0)
+	, bRequestedLoop(true)
+	, Thread(nullptr)
+{
+	for (const TArray<uint32>& ControlPoints : SectionsControlPoints)
+	{
+		for (const uint32 ControlPoint : ControlPoints)
+		{
+			NumControlPoints = FMath::Max(NumControlPoints, static_cast<int32>(ControlPoint) + 1);
+		}
+	}
+
+	if (Channel->frames.count > 0)
+	{
+		StartTime = Channel->frames.data[0].time;
+		Duration = Channel->frames.data[Channel->frames.count - 1].time - StartTime;
+		NumFrames = FMath::FloorToInt(Duration * FrameRate) + 1;
+	}
+
+	RingBuffer.AddDefaulted(FMath::Clamp(InRingBufferSize, 2, NumFrames));
+
+	WakeUpEvent = FPlatformProcess::GetSynchEventFromPool(false);
+}
+
+FglTFRuntimeFBXGeometryCacheStream::~FglTFRuntimeFBXGeometryCacheStream()
+{
+	if (Thread)
+	{
+		Thread->Kill(true);
+		delete Thread;
+	}
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeUpEvent);
+
+	if (GeometryCache)
+	{
+		ufbx_free_geometry_cache(GeometryCache);
+	}
+}
+
+void FglTFRuntimeFBXGeometryCacheStream::Start()
+{
+	if (!Thread)
+	{
+		Thread = FRunnableThread::Create(this, TEXT("glTFRuntimeFBXGeometryCacheStream"));
+	}
+}
+
+void FglTFRuntimeFBXGeometryCacheStream::Stop()
+{
+	bStopping = true;
+	WakeUpEvent->Trigger();
+}
+
+int32 FglTFRuntimeFBXGeometryCacheStream::GetWindowFrame(const int32 Offset) const
+{
+	const int32 FrameIndex = RequestedFrame + Offset;
+	if (FrameIndex < NumFrames)
+	{
+		return FrameIndex;
+	}
+
+	return bRequestedLoop ? FrameIndex % NumFrames : INDEX_NONE;
+}
+
+bool FglTFRuntimeFBXGeometryCacheStream::IsFrameInWindow(const int32 FrameIndex) const
+{
+	if (FrameIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	for (int32 Offset = 0; Offset < RingBuffer.Num(); Offset++)
+	{
+		if (GetWindowFrame(Offset) == FrameIndex)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+uint32 FglTFRuntimeFBXGeometryCacheStream::Run()
+{
+	TArray<ufbx_vec3> ControlPoints;
+	ControlPoints.AddZeroed(NumControlPoints);
+
+	TArray<TArray<FVector>> SectionsPositions;
+
+	ufbx_geometry_cache_data_opts Options = {};
+
+	while (!bStopping)
+	{
+		int32 FrameToStream = INDEX_NONE;
+		int32 SlotIndex = INDEX_NONE;
+
+		{
+			FScopeLock Lock(&RingBufferLock);
+
+			for (int32 Offset = 0; Offset < RingBuffer.Num(); Offset++)
+			{
+				const int32 FrameIndex = GetWindowFrame(Offset);
+				if (FrameIndex == INDEX_NONE)
+				{
+					break;
+				}
+
+				if (!RingBuffer.ContainsByPredicate([FrameIndex](const FFrameSlot& Slot) { return Slot.FrameIndex == FrameIndex; }))
+				{
+					FrameToStream = FrameIndex;
+					break;
+				}
+			}
+
+			if (FrameToStream != INDEX_NONE)
+			{
+				SlotIndex = RingBuffer.IndexOfByPredicate([this](const FFrameSlot& Slot) { return !IsFrameInWindow(Slot.FrameIndex); });
+			}
+		}
+
+		if (SlotIndex == INDEX_NONE)
+		{
+			WakeUpEvent->Wait(100);
+			continue;
+		}
+
+		// sampling (and the related file reads) happens without holding the lock
+		ufbx_sample_geometry_cache_vec3(Channel, StartTime + FrameToStream / FrameRate, ControlPoints.GetData(), ControlPoints.Num(), &Options);
+
+		SectionsPositions.SetNum(SectionsControlPoints.Num());
+		for (int32 SectionIndex = 0; SectionIndex < SectionsControlPoints.Num(); SectionIndex++)
+		{
+			const TArray<uint32>& SectionControlPoints = SectionsControlPoints[SectionIndex];
+			TArray<FVector>& Positions = SectionsPositions[SectionIndex];
+			Positions.SetNumUninitialized(SectionControlPoints.Num());
+			for (int32 VertexIndex = 0; VertexIndex < SectionControlPoints.Num(); VertexIndex++)
+			{
+				const ufbx_vec3& ControlPoint = ControlPoints[SectionControlPoints[VertexIndex]];
+				Positions[VertexIndex] = FVector(PositionsTransform.TransformPosition(FVector(ControlPoint.x, ControlPoint.y, ControlPoint.z)));
+			}
+		}
+
+		{
+			FScopeLock Lock(&RingBufferLock);
+			// swap the buffers, so the recycled slot allocations are reused by the next frame
+			Swap(RingBuffer[SlotIndex].SectionsPositions, SectionsPositions);
+			RingBuffer[SlotIndex].FrameIndex = FrameToStream;
+		}
+	}
+
+	return 0;
+}
+
+bool FglTFRuntimeFBXGeometryCacheStream::GetFrame(const int32 FrameIndex, const bool bLoop, TArray<TArray<FVector>>& SectionsPositions)
+{
+	bool bFound = false;
+
+	{
+		FScopeLock Lock(&RingBufferLock);
+
+		RequestedFrame = FMath::Clamp(FrameIndex, 0, NumFrames - 1);
+		bRequestedLoop = bLoop;
+
+		for (const FFrameSlot& Slot : RingBuffer)
+		{
+			if (Slot.FrameIndex == RequestedFrame)
+			{
+				SectionsPositions = Slot.SectionsPositions;
+				bFound = true;
+				break;
+			}
+		}
+	}
+
+	WakeUpEvent->Trigger();
+
+	return bFound;
+}
@@ -0,0 +1,63 @@
+// Copyright 2023-2024 - Roberto De Ioris
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+
+struct ufbx_geometry_cache;
+struct ufbx_cache_channel;
+
+/**
+ * Streams the frames of an FBX point cache (MC/PC2) in a small ring buffer filled by a worker thread,
+ * so long caches can be played without loading every frame in memory.
+ */
+class FglTFRuntimeFBXGeometryCacheStream : public FRunnable
+{
+public:
+	FglTFRuntimeFBXGeometryCacheStream(ufbx_geometry_cache* InGeometryCache, const ufbx_cache_channel* InChannel, const FMatrix& InPositionsTransform, TArray<TArray<uint32>>&& InSectionsControlPoints, const float InFrameRate, const int32 InRingBufferSize);
+	virtual ~FglTFRuntimeFBXGeometryCacheStream();
+
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+	void Start();
+
+	float GetDuration() const { return Duration; }
+	float GetFrameRate() const { return FrameRate; }
+	int32 GetNumFrames() const { return NumFrames; }
+
+	// moves the streaming window to FrameIndex, returns false if the frame is not available yet
+	bool GetFrame(const int32 FrameIndex, const bool bLoop, TArray<TArray<FVector>>& SectionsPositions);
+
+protected:
+	struct FFrameSlot
+	{
+		int32 FrameIndex = INDEX_NONE;
+		TArray<TArray<FVector>> SectionsPositions;
+	};
+
+	int32 GetWindowFrame(const int32 Offset) const;
+	bool IsFrameInWindow(const int32 FrameIndex) const;
+
+	ufbx_geometry_cache* GeometryCache;
+	const ufbx_cache_channel* Channel;
+	FMatrix PositionsTransform;
+	TArray<TArray<uint32>> SectionsControlPoints;
+	int32 NumControlPoints;
+
+	double StartTime;
+	float Duration;
+	float FrameRate;
+	int32 NumFrames;
+
+	TArray<FFrameSlot> RingBuffer;
+	FCriticalSection RingBufferLock;
+	int32 RequestedFrame;
+	bool bRequestedLoop;
+
+	FEvent* WakeUpEvent;
+	FRunnableThread* Thread;
+	FThreadSafeBool bStopping;
+};
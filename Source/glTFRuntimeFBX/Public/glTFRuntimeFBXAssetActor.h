@@ -20,6 +20,40 @@ enum class EglTFRuntimeFBXAssetActorDefaultAnimation : uint8
 	None
 };
 
+// static meshes are shared by the nodes with the same mesh and the same materials
+struct FglTFRuntimeFBXSharedMeshKey
+{
+	uint32 MeshId = 0;
+	TArray<uint32> MaterialIds;
+
+	FglTFRuntimeFBXSharedMeshKey(const FglTFRuntimeFBXNode& FBXNode) : MeshId(FBXNode.MeshId), MaterialIds(FBXNode.MaterialIds)
+	{
+	}
+
+	bool operator==(const FglTFRuntimeFBXSharedMeshKey& Other) const
+	{
+		return MeshId == Other.MeshId && MaterialIds == Other.MaterialIds;
+	}
+};
+
+inline uint32 GetTypeHash(const FglTFRuntimeFBXSharedMeshKey& Key)
+{
+	uint32 Hash = GetTypeHash(Key.MeshId);
+	for (const uint32 MaterialId : Key.MaterialIds)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(MaterialId));
+	}
+	return Hash;
+}
+
+UENUM(BlueprintType)
+enum class EglTFRuntimeFBXAssetActorMeshInstancing : uint8
+{
+	None,
+	Instanced,
+	HierarchicalInstanced
+};
+
 UCLASS()
 class GLTFRUNTIMEFBX_API AglTFRuntimeFBXAssetActor : public AActor
 {
@@ -41,6 +75,27 @@ protected:
 
 	void ProcessNode(USceneComponent* CurrentParentComponent, const FglTFRuntimeFBXNode& FBXNode, const FName SocketName);
 
+	TArray<FglTFRuntimeMeshLOD> BuildLODChain(const FglTFRuntimeMeshLOD& LOD) const;
+
+	void LoadCollisions(UStaticMesh* StaticMesh, const FglTFRuntimeFBXNode& FBXNode);
+
+	USkeletalMesh* LoadSkeletalMesh(const TArray<FglTFRuntimeMeshLOD>& LODs, const FglTFRuntimeSkeletalMeshConfig& Config);
+
+	void MergeRigidMeshes(TArray<FglTFRuntimeMeshLOD>& LODs, const FglTFRuntimeFBXNode& SkeletalFBXNode);
+
+	bool HasBoneAncestor(const FglTFRuntimeFBXNode& FBXNode) const;
+
+	template<typename T>
+	T GetLODChainMeshConfig(const T& Config) const
+	{
+		T LODChainMeshConfig = Config;
+		for (int32 LODIndex = 0; LODIndex < MeshConfig.LODs.Num(); LODIndex++)
+		{
+			LODChainMeshConfig.LODScreenSize.Add(LODIndex + 1, MeshConfig.LODs[LODIndex].ScreenSize);
+		}
+		return LODChainMeshConfig;
+	}
+
 public:
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
@@ -57,6 +112,12 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true), Category = "glTFRuntime|FBX")
 	FglTFRuntimeSkeletalAnimationConfig SkeletalAnimationConfig;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true), Category = "glTFRuntime|FBX")
+	FglTFRuntimeFBXAnimationConfig AnimationConfig;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true), Category = "glTFRuntime|FBX")
+	FglTFRuntimeFBXMeshConfig MeshConfig;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true), Category = "glTFRuntime|FBX")
 	EglTFRuntimeFBXAssetActorDefaultAnimation DefaultAnimation;
 
@@ -78,6 +139,24 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true), Category = "glTFRuntime|FBX")
 	bool bLoadLights;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true), Category = "glTFRuntime|FBX")
+	EglTFRuntimeFBXAssetActorMeshInstancing MeshInstancing;
+
+	// UCX_, UBX_ and USP_ nodes become simple collisions of their render mesh (instead of being rendered)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true), Category = "glTFRuntime|FBX")
+	bool bLoadCollisions;
+
+	// skeletal meshes with the same hierarchy and reference pose use the same USkeleton (even across actors)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true), Category = "glTFRuntime|FBX")
+	bool bShareSkeletons;
+
+	// static meshes parented to bones are folded into the skeletal mesh as sections fully weighted to their bone
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true), Category = "glTFRuntime|FBX")
+	bool bMergeRigidMeshes;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Meta = (ExposeOnSpawn = true), Category = "glTFRuntime|FBX")
+	bool bPlayGeometryCaches;
+
 	UFUNCTION(BlueprintNativeEvent, Category = "glTFRuntime|FBX", meta = (DisplayName = "On StaticMeshComponent Created"))
 	void ReceiveOnStaticMeshComponentCreated(UStaticMeshComponent* StaticMeshComponent);
 
@@ -93,6 +172,22 @@ protected:
 
 	TArray<TPair<USceneComponent*, FName>> DiscoveredAttachments;
 
+	// demoted rigid skins, their meshes are already in bone space
+	TArray<TPair<USceneComponent*, FName>> DiscoveredRigidAttachments;
+
+	TMap<FglTFRuntimeFBXSharedMeshKey, UStaticMesh*> SharedStaticMeshes;
+
+	TMap<FglTFRuntimeFBXSharedMeshKey, class UInstancedStaticMeshComponent*> SharedInstancedStaticMeshComponents;
+
+	TMap<uint32, TArray<FglTFRuntimeFBXNode>> DiscoveredCollisions;
+
+	// static meshes parented to bones (candidates for bMergeRigidMeshes)
+	TMap<uint32, FglTFRuntimeFBXNode> RigidMeshes;
+
+	TSet<uint32> MergedRigidMeshes;
+
+	TArray<TPair<USceneComponent*, FglTFRuntimeFBXNode>> DiscoveredRigidMeshes;
+
 private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"), Category = "glTFRuntime|FBX")
 	USceneComponent* AssetRoot;
@@ -7,6 +7,17 @@
 #include "glTFRuntimeAsset.h"
 #include "glTFRuntimeFBXFunctionLibrary.generated.h"
 
+class UBodySetup;
+
+UENUM(BlueprintType)
+enum class EglTFRuntimeFBXCollisionShape : uint8
+{
+	None,
+	Convex,
+	Box,
+	Sphere
+};
+
 USTRUCT(BlueprintType)
 struct FglTFRuntimeFBXNode
 {
@@ -24,7 +35,26 @@ struct FglTFRuntimeFBXNode
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|FBX")
 	bool bIsLight = false;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|FBX")
+	bool bIsLODGroup = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|FBX")
+	bool bHasGeometryCache = false;
+
+	// UCX_, UBX_ and USP_ nodes
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|FBX")
+	EglTFRuntimeFBXCollisionShape CollisionShape = EglTFRuntimeFBXCollisionShape::None;
+
 	uint32 Id = 0;
+
+	uint32 MeshId = 0;
+
+	// per instance materials (a mesh can be instanced with different materials)
+	TArray<uint32> MaterialIds;
+
+	bool bHasGeometryTransform = false;
+
+	bool bHasSkin = false;
 };
 
 USTRUCT(BlueprintType)
@@ -41,6 +71,80 @@ struct FglTFRuntimeFBXAnim
 	uint32 Id = 0;
 };
 
+USTRUCT(BlueprintType)
+struct FglTFRuntimeFBXLODConfig
+{
+	GENERATED_BODY()
+
+	// fraction of the LOD0 triangles to keep
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|FBX")
+	float TrianglesRatio = 0.5f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|FBX")
+	float ScreenSize = 0.5f;
+};
+
+USTRUCT(BlueprintType)
+struct FglTFRuntimeFBXMeshConfig
+{
+	GENERATED_BODY()
+
+	// compute smooth normals (honoring smoothing groups) for meshes without them, instead of leaving it to glTFRuntime
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|FBX")
+	bool bGenerateMissingNormals = false;
+
+	// split static meshes bigger than this number of triangles in spatially coherent clusters (0 disables clustering)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|FBX")
+	int32 ClusterMaxTriangles = 0;
+
+	// weld vertices and reorder triangles (Tipsify) and vertices for post-transform cache and fetch locality
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|FBX")
+	bool bOptimizeVertexCache = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|FBX")
+	int32 VertexCacheSize = 16;
+
+	// additional LODs generated by quadric simplification (UV seams, material borders and skin weights are preserved)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|FBX")
+	TArray<FglTFRuntimeFBXLODConfig> LODs;
+
+	// remove the bones without weights and without weighted descendants (helpers, IK targets, end sites...)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|FBX")
+	bool bPruneUnweightedBones = false;
+
+	// bones never pruned (sockets), bones with attached meshes or lights are always kept
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|FBX")
+	TArray<FString> BonesToKeep;
+
+	// skins with every vertex fully weighted to a single bone are loaded as static meshes in the bone space (see GetFBXRigidSkinBone)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|FBX")
+	bool bDemoteRigidSkins = false;
+};
+
+USTRUCT(BlueprintType)
+struct FglTFRuntimeFBXAnimationConfig
+{
+	GENERATED_BODY()
+
+	// collapse the bone tracks that never move (within the tolerances) to a single key and remove the linearly interpolable morph target keys
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|FBX")
+	bool bReduceKeys = false;
+
+	// in translation units
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|FBX")
+	float TranslationTolerance = 0.001f;
+
+	// in degrees
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|FBX")
+	float RotationTolerance = 0.01f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|FBX")
+	float ScaleTolerance = 0.0001f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|FBX")
+	float MorphTargetTolerance = 0.0001f;
+};
+
 /**
  * 
  */
@@ -66,6 +170,12 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "glTFRuntime|FBX")
 	static bool GetFBXNodeParent(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode, FglTFRuntimeFBXNode& FBXParentNode);
 
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "glTFRuntime|FBX")
+	static TArray<FglTFRuntimeFBXNode> GetFBXMeshInstances(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "glTFRuntime|FBX")
+	static FTransform GetFBXNodeWorldTransform(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode);
+
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "glTFRuntime|FBX")
 	static TArray<FglTFRuntimeFBXAnim> GetFBXAnimations(UglTFRuntimeAsset* Asset);
 
@@ -75,8 +185,46 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "glTFRuntime|FBX")
 	static bool IsFBXNodeBone(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode);
 
-	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "MaterialsConfig", AutoCreateRefTerm = "StaticMeshMaterialsConfig,SkeletalMeshMaterialsConfig"), Category = "glTFRuntime|FBX")
-	static bool LoadFBXAsRuntimeLODByNode(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode, FglTFRuntimeMeshLOD& RuntimeLOD, bool& bIsSkeletal, const FglTFRuntimeMaterialsConfig& StaticMeshMaterialsConfig, const FglTFRuntimeMaterialsConfig& SkeletalMeshMaterialsConfig);
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "glTFRuntime|FBX")
+	static bool GetFBXRigidSkinBone(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode, FglTFRuntimeFBXNode& BoneFBXNode);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "glTFRuntime|FBX")
+	static bool GetFBXCollisionOwnerNode(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& CollisionFBXNode, FglTFRuntimeFBXNode& OwnerFBXNode);
+
+	UFUNCTION(BlueprintCallable, Category = "glTFRuntime|FBX")
+	static bool AddFBXCollisionToBodySetup(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& CollisionFBXNode, const FglTFRuntimeFBXNode& OwnerFBXNode, UBodySetup* BodySetup);
+
+	// returns a skeleton previously registered with the same hierarchy and reference pose of the RuntimeLOD
+	UFUNCTION(BlueprintCallable, Category = "glTFRuntime|FBX")
+	static USkeleton* GetFBXSharedSkeleton(const FglTFRuntimeMeshLOD& RuntimeLOD);
+
+	UFUNCTION(BlueprintCallable, Category = "glTFRuntime|FBX")
+	static void RegisterFBXSharedSkeleton(const FglTFRuntimeMeshLOD& RuntimeLOD, USkeleton* Skeleton);
+
+	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "MaterialsConfig", AutoCreateRefTerm = "StaticMeshMaterialsConfig,SkeletalMeshMaterialsConfig,MeshConfig"), Category = "glTFRuntime|FBX")
+	static bool LoadFBXAsRuntimeLODByNode(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode, FglTFRuntimeMeshLOD& RuntimeLOD, bool& bIsSkeletal, const FglTFRuntimeMaterialsConfig& StaticMeshMaterialsConfig, const FglTFRuntimeMaterialsConfig& SkeletalMeshMaterialsConfig, const FglTFRuntimeFBXMeshConfig& MeshConfig);
+
+	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "StaticMeshMaterialsConfig", AutoCreateRefTerm = "StaticMeshMaterialsConfig"), Category = "glTFRuntime|FBX")
+	static bool LoadFBXPosedNodeAsStaticRuntimeLOD(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode, const FglTFRuntimeFBXAnim& FBXAnim, const float Time, FglTFRuntimeMeshLOD& RuntimeLOD, const FglTFRuntimeMaterialsConfig& StaticMeshMaterialsConfig);
+
+	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "MaterialsConfig", AutoCreateRefTerm = "StaticMeshMaterialsConfig,SkeletalMeshMaterialsConfig,MeshConfig"), Category = "glTFRuntime|FBX")
+	static bool LoadFBXAsRuntimeLODClustersByNode(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode, TArray<FglTFRuntimeMeshLOD>& RuntimeLODs, bool& bIsSkeletal, const FglTFRuntimeMaterialsConfig& StaticMeshMaterialsConfig, const FglTFRuntimeMaterialsConfig& SkeletalMeshMaterialsConfig, const FglTFRuntimeFBXMeshConfig& MeshConfig);
+
+	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "MaterialsConfig", AutoCreateRefTerm = "StaticMeshMaterialsConfig,SkeletalMeshMaterialsConfig,MeshConfig"), Category = "glTFRuntime|FBX")
+	static bool LoadFBXLODGroupAsRuntimeLODs(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode, TArray<FglTFRuntimeMeshLOD>& RuntimeLODs, TArray<float>& ScreenSizes, bool& bIsSkeletal, const FglTFRuntimeMaterialsConfig& StaticMeshMaterialsConfig, const FglTFRuntimeMaterialsConfig& SkeletalMeshMaterialsConfig, const FglTFRuntimeFBXMeshConfig& MeshConfig);
+
+	UFUNCTION(BlueprintCallable, Category = "glTFRuntime|FBX")
+	static void GenerateFBXRuntimeLODs(const FglTFRuntimeMeshLOD& RuntimeLOD, const TArray<FglTFRuntimeFBXLODConfig>& LODsConfig, TArray<FglTFRuntimeMeshLOD>& RuntimeLODs);
+
+	UFUNCTION(BlueprintCallable, Category = "glTFRuntime|FBX")
+	static void OptimizeFBXRuntimeLOD(UPARAM(ref) FglTFRuntimeMeshLOD& RuntimeLOD, const int32 VertexCacheSize, float& ACMRBefore, float& ACMRAfter);
+
+	UFUNCTION(BlueprintCallable, Category = "glTFRuntime|FBX")
+	static int32 PruneFBXRuntimeLODBones(UPARAM(ref) FglTFRuntimeMeshLOD& RuntimeLOD, const TArray<FString>& BonesToKeep);
+
+	// folds a static mesh node parented to a bone of the skeleton of SkeletalFBXNode (the node RuntimeLOD was loaded from), its vertices are fully weighted to the bone
+	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "MaterialsConfig", AutoCreateRefTerm = "SkeletalMeshMaterialsConfig,MeshConfig"), Category = "glTFRuntime|FBX")
+	static bool MergeFBXRigidNodeIntoRuntimeLOD(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode, const FglTFRuntimeFBXNode& SkeletalFBXNode, UPARAM(ref) FglTFRuntimeMeshLOD& RuntimeLOD, const FglTFRuntimeMaterialsConfig& SkeletalMeshMaterialsConfig, const FglTFRuntimeFBXMeshConfig& MeshConfig);
 
 	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "MaterialsConfig", AutoCreateRefTerm = "SkeletalMeshMaterialsConfig"), Category = "glTFRuntime|FBX")
 	static bool LoadAndMergeFBXAsRuntimeLODBySkinDeformer(UglTFRuntimeAsset* Asset, const int32 SkinDeformerIndex, FglTFRuntimeMeshLOD& RuntimeLOD, const FglTFRuntimeMaterialsConfig& SkeletalMeshMaterialsConfig);
@@ -87,20 +235,27 @@ public:
 	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "MaterialsConfig", AutoCreateRefTerm = "SkeletalMeshMaterialsConfig"), Category = "glTFRuntime|FBX")
 	static bool LoadAndMergeFBXAsRuntimeLODsGroupBySkinDeformer(UglTFRuntimeAsset* Asset, TArray<FglTFRuntimeMeshLOD>& RuntimeLODs, const FglTFRuntimeMaterialsConfig& SkeletalMeshMaterialsConfig);
 
-	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "SkeletalAnimationConfig", AutoCreateRefTerm = "SkeletalAnimationConfig"), Category = "glTFRuntime|FBX")
-	static UAnimSequence* LoadFBXAnimAsSkeletalMeshAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, const FglTFRuntimeFBXNode& FBXNode, USkeletalMesh* SkeletalMesh, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig);
+	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "MaterialsConfig", AutoCreateRefTerm = "StaticMeshMaterialsConfig"), Category = "glTFRuntime|FBX")
+	static bool LoadAndMergeFBXStaticNodesAsRuntimeLODs(UglTFRuntimeAsset* Asset, TArray<FglTFRuntimeMeshLOD>& RuntimeLODs, const FglTFRuntimeMaterialsConfig& StaticMeshMaterialsConfig, const float ClusterSize = 0);
 
-	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "SkeletalAnimationConfig", AutoCreateRefTerm = "SkeletalAnimationConfig"), Category = "glTFRuntime|FBX")
-	static UAnimSequence* LoadFBXAnimAsSkeletalAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, const FglTFRuntimeFBXNode& FBXNode, USkeleton* Skeleton, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig);
+	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "SkeletalAnimationConfig,AnimationConfig", AutoCreateRefTerm = "SkeletalAnimationConfig,AnimationConfig"), Category = "glTFRuntime|FBX")
+	static UAnimSequence* LoadFBXAnimAsSkeletalMeshAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, const FglTFRuntimeFBXNode& FBXNode, USkeletalMesh* SkeletalMesh, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, const FglTFRuntimeFBXAnimationConfig& AnimationConfig);
 
-	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "SkeletalAnimationConfig", AutoCreateRefTerm = "SkeletalAnimationConfig"), Category = "glTFRuntime|FBX")
-	static UAnimSequence* LoadFBXExternalAnimAsSkeletalMeshAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, USkeletalMesh* SkeletalMesh, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig);
+	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "SkeletalAnimationConfig,AnimationConfig", AutoCreateRefTerm = "SkeletalAnimationConfig,AnimationConfig"), Category = "glTFRuntime|FBX")
+	static UAnimSequence* LoadFBXAnimAsSkeletalAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, const FglTFRuntimeFBXNode& FBXNode, USkeleton* Skeleton, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, const FglTFRuntimeFBXAnimationConfig& AnimationConfig);
 
-	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "SkeletalAnimationConfig", AutoCreateRefTerm = "SkeletalAnimationConfig"), Category = "glTFRuntime|FBX")
-	static UAnimSequence* LoadFBXExternalAnimAsSkeletalAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, USkeleton* Skeleton, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig);
+	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "SkeletalAnimationConfig,AnimationConfig", AutoCreateRefTerm = "SkeletalAnimationConfig,AnimationConfig"), Category = "glTFRuntime|FBX")
+	static UAnimSequence* LoadFBXExternalAnimAsSkeletalMeshAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, USkeletalMesh* SkeletalMesh, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, const FglTFRuntimeFBXAnimationConfig& AnimationConfig);
 
-	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "SkeletalAnimationConfig", AutoCreateRefTerm = "SkeletalAnimationConfig"), Category = "glTFRuntime|FBX")
-	static UAnimSequence* LoadFBXRawAnimAsSkeletalAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, USkeleton* Skeleton, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig);
+	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "SkeletalAnimationConfig,AnimationConfig", AutoCreateRefTerm = "SkeletalAnimationConfig,AnimationConfig"), Category = "glTFRuntime|FBX")
+	static UAnimSequence* LoadFBXExternalAnimAsSkeletalAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, USkeleton* Skeleton, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, const FglTFRuntimeFBXAnimationConfig& AnimationConfig);
+
+	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "SkeletalAnimationConfig,AnimationConfig", AutoCreateRefTerm = "SkeletalAnimationConfig,AnimationConfig"), Category = "glTFRuntime|FBX")
+	static UAnimSequence* LoadFBXRawAnimAsSkeletalAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, USkeleton* Skeleton, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, const FglTFRuntimeFBXAnimationConfig& AnimationConfig);
+
+	// every anim stack (bones only) sampled in parallel, keyed by the anim stack name (empty and duplicated names get an index suffix)
+	UFUNCTION(BlueprintCallable, meta = (AdvancedDisplay = "SkeletalAnimationConfig,AnimationConfig", AutoCreateRefTerm = "SkeletalAnimationConfig,AnimationConfig"), Category = "glTFRuntime|FBX")
+	static TMap<FString, UAnimSequence*> LoadAllFBXAnimsAsSkeletalAnimations(UglTFRuntimeAsset* Asset, USkeleton* Skeleton, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, const FglTFRuntimeFBXAnimationConfig& AnimationConfig);
 
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "glTFRuntime|FBX")
 	static int32 GetFBXSkinDeformersNum(UglTFRuntimeAsset* Asset);
@@ -109,6 +264,17 @@ public:
 	static ULightComponent* LoadFBXLight(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode, AActor* Actor, const FglTFRuntimeLightConfig& LightConfig);
 
 
-	static bool FillFBXPrimitives(UglTFRuntimeAsset* Asset, TSharedPtr<struct FglTFRuntimeFBXCacheData> RuntimeFBXCacheData, struct ufbx_node* Node, const int32 PrimitiveBase, TArray<FglTFRuntimePrimitive>& Primitives, const TMap<uint32, TArray<TPair<int32, float>>>& JointsWeightsMap, const int32 JointsWeightsGroups, const FglTFRuntimeMaterialsConfig& MaterialsConfig);
+	// pre-MeshConfig signature, kept for C++ callers
+	static bool LoadFBXAsRuntimeLODByNode(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode, FglTFRuntimeMeshLOD& RuntimeLOD, bool& bIsSkeletal, const FglTFRuntimeMaterialsConfig& StaticMeshMaterialsConfig, const FglTFRuntimeMaterialsConfig& SkeletalMeshMaterialsConfig);
+
+	// pre-AnimationConfig signatures, kept for C++ callers
+	static UAnimSequence* LoadFBXAnimAsSkeletalMeshAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, const FglTFRuntimeFBXNode& FBXNode, USkeletalMesh* SkeletalMesh, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig);
+	static UAnimSequence* LoadFBXAnimAsSkeletalAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, const FglTFRuntimeFBXNode& FBXNode, USkeleton* Skeleton, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig);
+	static UAnimSequence* LoadFBXExternalAnimAsSkeletalMeshAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, USkeletalMesh* SkeletalMesh, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig);
+	static UAnimSequence* LoadFBXExternalAnimAsSkeletalAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, USkeleton* Skeleton, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig);
+	static UAnimSequence* LoadFBXRawAnimAsSkeletalAnimation(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXAnim& FBXAnim, USkeleton* Skeleton, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig);
+
+	static bool FillFBXPrimitives(UglTFRuntimeAsset* Asset, TSharedPtr<struct FglTFRuntimeFBXCacheData> RuntimeFBXCacheData, struct ufbx_node* Node, const int32 PrimitiveBase, TArray<FglTFRuntimePrimitive>& Primitives, const TMap<uint32, TArray<TPair<int32, float>>>& JointsWeightsMap, const int32 JointsWeightsGroups, const FglTFRuntimeMaterialsConfig& MaterialsConfig, TArray<TArray<uint32>>* PrimitivesControlPoints = nullptr);
+	static TSharedPtr<class FglTFRuntimeFBXGeometryCacheStream> LoadFBXGeometryCacheStream(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode, FglTFRuntimeMeshLOD& RuntimeLOD, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const float FrameRate, const int32 RingBufferSize);
 	static bool FillFBXSkinDeformer(UglTFRuntimeAsset* Asset, struct ufbx_skin_deformer* SkinDeformer, TArray<FglTFRuntimeBone>& Skeleton, TMap<uint32, TArray<TPair<int32, float>>>& JointsWeightsMap, int32& JointsWeightsGroups);
 };
@@ -0,0 +1,56 @@
+// Copyright 2023-2024 - Roberto De Ioris
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProceduralMeshComponent.h"
+#include "glTFRuntimeFBXFunctionLibrary.h"
+#include "glTFRuntimeFBXGeometryCacheComponent.generated.h"
+
+/**
+ * Plays the point cache (MC/PC2) of an FBX mesh node, frames are streamed from disk by a worker thread.
+ */
+UCLASS(ClassGroup = (glTFRuntime), meta = (BlueprintSpawnableComponent))
+class GLTFRUNTIMEFBX_API UglTFRuntimeFBXGeometryCacheComponent : public UProceduralMeshComponent
+{
+	GENERATED_BODY()
+
+public:
+	UglTFRuntimeFBXGeometryCacheComponent();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void OnComponentDestroyed(bool bDestroyingHierarchy) override;
+
+	UFUNCTION(BlueprintCallable, meta = (AutoCreateRefTerm = "MaterialsConfig"), Category = "glTFRuntime|FBX")
+	bool LoadFBXGeometryCache(UglTFRuntimeAsset* Asset, const FglTFRuntimeFBXNode& FBXNode, const FglTFRuntimeMaterialsConfig& MaterialsConfig);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "glTFRuntime|FBX")
+	float GetDuration() const;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|FBX")
+	bool bPlaying;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|FBX")
+	bool bLoop;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|FBX")
+	float PlayRate;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|FBX")
+	float CurrentTime;
+
+	// frames per second sampled from the cache (changes are applied on the next load)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|FBX")
+	float FrameRate;
+
+	// number of frames streamed ahead of the current one (changes are applied on the next load)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime|FBX")
+	int32 RingBufferSize;
+
+protected:
+	TSharedPtr<class FglTFRuntimeFBXGeometryCacheStream> Stream;
+
+	TArray<TArray<FVector>> SectionsPositions;
+
+	int32 CurrentFrame;
+};
@@ -26,6 +26,7 @@ public class glTFRuntimeFBX : ModuleRules
 			new string[]
 			{
 				"Core",
+				"ProceduralMeshComponent",
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -36,6 +37,7 @@ public class glTFRuntimeFBX : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"PhysicsCore",
 				"glTFRuntime"
 			}
 			);